@@ -0,0 +1,151 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file all_different.h
+ * @brief This file defines the all-different propagator of the search: a matching between the nodes of T1 and their candidates.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - domains.h: Definition of the domains whose candidates are matched.
+ */
+
+#ifndef ALL_DIFFERENT_H
+#define ALL_DIFFERENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "domains.h"
+
+/**
+ * @struct AllDifferent
+ * @brief This structure contains a maximum matching between the nodes of T1 and the nodes of T2, and the buffers used to
+ *        repair it and to filter the domains.
+ *
+ * Every mapping that extends the current one maps the nodes of T1 to distinct candidates, so when no matching covers T1 (a set
+ * of k nodes of T1 has fewer than k candidates, a Hall violation) the current mapping is a dead end, even if every node still
+ * has candidates. When a matching covers T1 and T2, a candidate v of u belongs to some of them only if it is the match of u
+ * or if u and the node matched to v are in the same strongly connected component of the graph that links every node of T1 to
+ * the nodes matched to its candidates (Régin): every other candidate is removed from the domain of u.
+ * The nodes of T1_tilde can be left out: their candidates are in T2_tilde, disjoint from T2, and their domains are their classes.
+ * The matching is kept from a call to the next one: the pairs no longer valid are dropped and the free nodes of T1 are matched
+ * with augmenting paths, usually a few, since a search step changes the frontier around one node.
+ * A removal depends on the whole mapping, so the failures of the nodes whose candidates were scanned after it are explained by
+ * every depth up to the one that made it, as well as by their usual reasons (see backjump.h).
+ *
+ * @var AllDifferent::num_nodes
+ * Number of nodes of the graphs.
+ * @var AllDifferent::words
+ * Number of words of each bitset.
+ * @var AllDifferent::period
+ * The propagator runs after the assignments of the depths period - 1, 2 * period - 1, ...
+ * @var AllDifferent::pruned_depth
+ * Deepest depth, among each depth and the ones before it, whose assignment removed candidates from the domains; -1 if none did.
+ * @var AllDifferent::mate1
+ * Node of G2 matched to each node of G1, -1 if it is free.
+ * @var AllDifferent::mate2
+ * Node of G1 matched to each node of G2, -1 if it is free.
+ * @var AllDifferent::visited
+ * Bitset of the nodes of G2 reached by the search of an augmenting path.
+ * @var AllDifferent::frame_node
+ * Node of G1 of each frame of the depth-first searches (augmenting paths and components).
+ * @var AllDifferent::frame_via
+ * Candidate of the node of each frame through which the path goes on.
+ * @var AllDifferent::frame_cursor
+ * Next node of G2 to be checked by each frame.
+ * @var AllDifferent::index
+ * Order in which the nodes of T1 are reached by the search of the components, -1 before.
+ * @var AllDifferent::low
+ * Smallest index reachable from each node of T1 through the nodes of its component not yet closed.
+ * @var AllDifferent::component
+ * Component of each node of T1, -1 while it is open.
+ * @var AllDifferent::open
+ * Nodes whose component is still open, in the order they were reached.
+ */
+typedef struct {
+    int num_nodes;
+    int words;
+    int period;
+    int* pruned_depth;
+    int* mate1;
+    int* mate2;
+    uint64_t* visited;
+    int* frame_node;
+    int* frame_via;
+    int* frame_cursor;
+    int* index;
+    int* low;
+    int* component;
+    int* open;
+} AllDifferent;
+
+/**
+ * @brief This function allocates the propagator, with an empty matching.
+ *
+ * @param all_different Pointer to the structure to be initialized.
+ * @param num_nodes Number of nodes of the graphs.
+ * @param words Number of words of each bitset.
+ * @param period Number of depths between two runs of the propagator.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool init_all_different(AllDifferent* all_different, int num_nodes, int words, int period);
+
+/**
+ * @brief Frees up the memory allocated for the propagator.
+ *
+ * @param all_different Pointer to the structure to be freed.
+ */
+void free_all_different(AllDifferent* all_different);
+
+/**
+ * @brief This function runs the propagator after the assignment of a depth, when the depth is one of those selected by the
+ *        period: it checks that the candidates of the nodes of T1 (their domains AND T2) admit an injective assignment, and
+ *        removes from the domains the candidates that belong to none.
+ *
+ * The removals are made with `remove_domain_value`, so they are undone when the pair of the depth is unmapped.
+ *
+ * @param all_different Pointer to the propagator.
+ * @param domains Pointer to the domains, with the pair of the depth mapped.
+ * @param T1 Bitset of the unmapped nodes of G1 with a mapped neighbor.
+ * @param T2 Bitset of the unmapped nodes of G2 with a mapped neighbor.
+ * @param depth The depth of the last pair mapped.
+ * @return False if no matching covers T1, so that no mapping extends the current one; true otherwise.
+ */
+bool propagate_all_different(AllDifferent* all_different, Domains* domains, const uint64_t* T1, const uint64_t* T2, int depth);
+
+/**
+ * @brief This function returns the deepest depth below a depth whose assignment removed candidates from the domains.
+ *
+ * @param all_different Pointer to the propagator.
+ * @param depth The depth.
+ * @return The depth, -1 if none of the depths below `depth` removed candidates.
+ */
+static inline int pruned_below(const AllDifferent* all_different, int depth) {
+    return (depth > 0) ? all_different->pruned_depth[depth - 1] : -1;
+}
+
+#endif // ALL_DIFFERENT_H
@@ -0,0 +1,72 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file arc_consistency.h
+ * @brief This file defines the filtering of the initial domains of the nodes of G1 by neighborhood arc consistency, run before
+ *        the search.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - find_candidates.h: Definition of the classes of the nodes.
+ * - domains.h: Definition of the domains filtered.
+ */
+
+#ifndef ARC_CONSISTENCY_H
+#define ARC_CONSISTENCY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+#include "find_candidates.h"
+#include "domains.h"
+
+/* Work allowed to the filtering: adjacency bitsets ORed, per node of the graphs */
+#define ARC_CONSISTENCY_MAX_WORK 64
+
+/**
+ * @brief This function filters the domains of an empty mapping (the classes of the nodes) to a fixpoint of neighborhood arc
+ *        consistency: v stays in the domain of u only if every neighbor of u has a node of its domain among the neighbors of v,
+ *        since a mapping that sends u to v sends the neighbors of u to neighbors of v.
+ *
+ * Each sweep computes, for every node w whose domain changed in the previous one, its support: the nodes of G2 adjacent to
+ * some node of its domain (the support of an unchanged domain is shared by its whole class), then ANDs the domain of every node
+ * with the supports of its neighbors. Both steps are run in parallel over the nodes when the program is built with OpenMP.
+ * The sweeps stop at the fixpoint, or when `ARC_CONSISTENCY_MAX_WORK` bitsets per node have been ORed: every removal is
+ * justified, so the domains are valid at any point. The filtered domains become the initial domains of the search.
+ * When memory cannot be allocated the domains are left as they are.
+ *
+ * @param domains Pointer to the domains, initialized with the classes and no pair mapped.
+ * @param G1 Pointer to G1 graph.
+ * @param filter Pointer to the bitsets of the classes of G2.
+ * @param adjacency2 Adjacency bitsets of G2.
+ * @return False if a domain has been emptied, or a node of G2 is in no domain: no mapping exists. True otherwise.
+ */
+bool arc_consistency(Domains* domains, Graph* G1, const CandidateFilter* filter, const uint64_t* adjacency2);
+
+#endif // ARC_CONSISTENCY_H
@@ -0,0 +1,145 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file backjump.h
+ * @brief This file defines the conflict sets used by the search to backjump to the deepest assignment that caused a failure.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - bitset.h: Definition of the bitsets that store the conflict sets.
+ */
+
+#ifndef BACKJUMP_H
+#define BACKJUMP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "bitset.h"
+
+/**
+ * @struct ConflictSets
+ * @brief This structure contains the conflict set of each depth of a search with a fixed node order.
+ *
+ * The conflict set of depth d holds the earlier depths whose assignments rejected some candidate of the node matched at d. When
+ * every candidate has failed, no assignment of the other depths can help: the search jumps straight back to the deepest depth of
+ * the set, instead of the previous one, and that depth inherits the rest of the set (conflict-directed backjumping).
+ * The set of depth d only holds depths below d, so the sets are stored as a triangle of bitsets: about num_depths^2 / 128 bytes.
+ *
+ * @var ConflictSets::num_depths
+ * Number of depths (the nodes of the graphs).
+ * @var ConflictSets::offset
+ * Index in `bits` of the first word of the set of each depth.
+ * @var ConflictSets::bits
+ * Words of all the sets.
+ * @var ConflictSets::full
+ * True for the depths whose set holds every earlier depth, so that the reasons of their failures need not be found.
+ * @var ConflictSets::depth_of
+ * Depth at which each node of G1 is matched: the inverse of the node order, updated when the node is mapped since the order can
+ * also be chosen during the search.
+ * @var ConflictSets::entered
+ * Depth of the assignment that added each node of G2 to T2, valid while the node is in T2.
+ * @var ConflictSets::scratch
+ * Buffer of num_depths entries, used to sort the depths that added the neighbors of a candidate to T2.
+ */
+typedef struct {
+    int num_depths;
+    size_t* offset;
+    uint64_t* bits;
+    bool* full;
+    int* depth_of;
+    int* entered;
+    int* scratch;
+} ConflictSets;
+
+/**
+ * @brief This function allocates empty conflict sets for a search.
+ *
+ * @param conflicts Pointer to the conflict sets to be initialized.
+ * @param node_order Order in which the nodes of G1 are matched.
+ * @param num_nodes Number of nodes of the graphs.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool init_conflict_sets(ConflictSets* conflicts, const int* node_order, int num_nodes);
+
+/**
+ * @brief Frees up the memory allocated for the conflict sets.
+ *
+ * @param conflicts Pointer to the conflict sets to be freed.
+ */
+void free_conflict_sets(ConflictSets* conflicts);
+
+/**
+ * @brief This function empties the conflict set of a depth, when a new node is matched there.
+ *
+ * @param conflicts Pointer to the conflict sets.
+ * @param depth The depth.
+ */
+void clear_conflict_set(ConflictSets* conflicts, int depth);
+
+/**
+ * @brief This function adds an earlier depth to the conflict set of a depth.
+ *
+ * @param conflicts Pointer to the conflict sets.
+ * @param depth The depth whose set is updated.
+ * @param culprit The earlier depth, below `depth`.
+ */
+static inline void add_conflict(ConflictSets* conflicts, int depth, int culprit) {
+    bitset_set(conflicts->bits + conflicts->offset[depth], culprit);
+}
+
+/**
+ * @brief This function adds every earlier depth to the conflict set of a depth, when the reason of a failure is not known:
+ *        the search then backtracks to the previous depth.
+ *
+ * @param conflicts Pointer to the conflict sets.
+ * @param depth The depth whose set is updated.
+ */
+void add_all_conflicts(ConflictSets* conflicts, int depth);
+
+/**
+ * @brief This function adds the depths up to `last` to the conflict set of a depth, when a failure may depend on every
+ *        assignment up to that depth.
+ *
+ * @param conflicts Pointer to the conflict sets.
+ * @param depth The depth whose set is updated.
+ * @param last The deepest depth added, below `depth`.
+ */
+void add_conflict_prefix(ConflictSets* conflicts, int depth, int last);
+
+/**
+ * @brief This function finds the depth to jump back to when every candidate of a depth has failed, and passes it the rest of the set.
+ *
+ * @param conflicts Pointer to the conflict sets.
+ * @param depth The depth that failed.
+ * @return The deepest depth in the conflict set of `depth`, whose set receives the other depths of it; -1 if the set is empty,
+ *         i.e. the failure does not depend on any assignment and the search is over.
+ */
+int conflict_jump(ConflictSets* conflicts, int depth);
+
+#endif // BACKJUMP_H
@@ -0,0 +1,63 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file core.h
+ * @brief This file defines the isomorphism test that runs VF2++ only on the 2-cores of the graphs, with the trees hanging from them as node labels.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - vf2pp.h: Definition of the VF2++ search run on the 2-cores.
+ */
+
+#ifndef CORE_H
+#define CORE_H
+
+#include "graph.h"
+#include "vf2pp.h"
+
+/**
+ * @brief This function checks whether two graphs are isomorphic by matching their 2-cores, when nodes of degree 1 hang from G1.
+ *
+ * The nodes of degree 1 are removed from both graphs until only the 2-cores are left (see find_hanging_trees): every pendant
+ * chain or tree is then summarized by the AHU label of the tree hanging from its node of the 2-core. The graphs are isomorphic
+ * exactly when their 2-cores are, by a mapping that preserves these labels: VF2++ runs on the 2-cores with the labels in the node
+ * keys, so that a node is only mapped to a node with the same hanging tree, and the trees are then mapped in linear time.
+ * Symmetry breaking is disabled, since the automorphisms of a 2-core do not preserve the labels. When the graphs are isomorphic,
+ * the `mapped` field of each node of G1 (G2) contains its image in G2 (G1).
+ *
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param options Pointer to the options of the search of the 2-cores, NULL for the default ones.
+ * @param stats Pointer filled with the statistics of the search, NULL if they are not needed.
+ * @return 1 if the graphs are isomorphic, 0 if they are not, -1 if no node of G1 has degree 1 (or G1 has self loops, or its 2-core is empty, or the graphs
+ *         have different sizes, or memory cannot be allocated) and the search must be run on the whole graphs.
+ */
+int core_isomorphic(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats);
+
+#endif // CORE_H
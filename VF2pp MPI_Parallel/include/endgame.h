@@ -0,0 +1,143 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file endgame.h
+ * @brief This file defines the endgame of the search: the last unmapped nodes are matched in a single step.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ */
+
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+
+/* Largest number of unmapped nodes handled by the endgame: the nodes of each side fit in the bits of a word */
+#define ENDGAME_MAX_NODES 64
+/* Assignments tried by the exhaustive endgame before it gives up and the search goes on one node at a time */
+#define ENDGAME_MAX_STEPS 65536
+
+/* Results of solve_endgame */
+#define ENDGAME_UNKNOWN -1
+#define ENDGAME_NONE 0
+#define ENDGAME_FOUND 1
+
+/**
+ * @struct Endgame
+ * @brief This structure contains the buffers of the endgame, reserved once for the whole search.
+ *
+ * The k unmapped nodes of G1 and of G2 are numbered from 0 to k-1, so that the sets of nodes are words.
+ * A pair (u, v) of unmapped nodes is compatible when v has the key of u (its signature when both graphs have one, its degree
+ * otherwise) and the mapped neighbors of v are exactly the images of the mapped neighbors of u: these are the only conditions
+ * on the pair that depend on the mapping. A completion of the mapping is then a bijection between the unmapped nodes made of
+ * compatible pairs that also preserves the edges between unmapped nodes.
+ *
+ * @var Endgame::num_nodes
+ * Number of nodes of the graphs.
+ * @var Endgame::threshold
+ * The endgame runs when this many nodes are left unmapped (or fewer, for graphs with fewer nodes).
+ * @var Endgame::nodes1
+ * Unmapped nodes of G1.
+ * @var Endgame::nodes2
+ * Unmapped nodes of G2.
+ * @var Endgame::compatible
+ * For each unmapped node of G1, the set of the unmapped nodes of G2 it is compatible with.
+ * @var Endgame::adjacent1
+ * For each unmapped node of G1, the set of its unmapped neighbors.
+ * @var Endgame::adjacent2
+ * For each unmapped node of G2, the set of its unmapped neighbors.
+ * @var Endgame::image
+ * Unmapped node of G2 assigned to each unmapped node of G1 (its number), -1 if none.
+ * @var Endgame::preimage
+ * Unmapped node of G1 assigned to each unmapped node of G2 (its number), -1 if none.
+ * @var Endgame::order
+ * Order in which the exhaustive endgame assigns the unmapped nodes of G1: by ascending number of compatible nodes.
+ * @var Endgame::candidates
+ * Compatible nodes of G2 not yet tried at each position of `order`, during the exhaustive endgame.
+ * @var Endgame::number1
+ * Number of each node of G1 among the unmapped nodes, -1 if it is mapped (or between two endgames).
+ * @var Endgame::number2
+ * Number of each node of G2 among the unmapped nodes, -1 if it is mapped (or between two endgames).
+ * @var Endgame::marked
+ * True for the mapped neighbors of the unmapped node of G1 whose compatible nodes are being found.
+ */
+typedef struct {
+    int num_nodes;
+    int threshold;
+    int* nodes1;
+    int* nodes2;
+    uint64_t* compatible;
+    uint64_t* adjacent1;
+    uint64_t* adjacent2;
+    int* image;
+    int* preimage;
+    int* order;
+    uint64_t* candidates;
+    int* number1;
+    int* number2;
+    bool* marked;
+} Endgame;
+
+/**
+ * @brief This function reserves the buffers of the endgame.
+ *
+ * @param endgame Pointer to the structure to be initialized.
+ * @param num_nodes Number of nodes of the graphs.
+ * @param threshold Number of unmapped nodes at which the endgame runs, between 1 and ENDGAME_MAX_NODES.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool init_endgame(Endgame* endgame, int num_nodes, int threshold);
+
+/**
+ * @brief Frees up the memory allocated for the buffers.
+ *
+ * @param endgame Pointer to the structure to be freed.
+ */
+void free_endgame(Endgame* endgame);
+
+/**
+ * @brief This function looks for a completion of the current mapping (the `mapped` fields of the graphs), in which at most
+ *        `threshold` nodes are unmapped.
+ *
+ * When the unmapped nodes of G1 are not adjacent to each other, a completion is a perfect matching of the compatible pairs.
+ * Otherwise a perfect matching is only necessary, and the bijections are tried exhaustively, with the sets of nodes as words,
+ * for at most ENDGAME_MAX_STEPS assignments.
+ *
+ * @param endgame Pointer to the buffers.
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @return ENDGAME_FOUND if a completion has been found (the unmapped nodes are then mapped in both graphs), ENDGAME_NONE if
+ *         there is none, ENDGAME_UNKNOWN if the exhaustive endgame gave up (the graphs are left unchanged).
+ */
+int solve_endgame(Endgame* endgame, Graph* G1, Graph* G2);
+
+#endif // ENDGAME_H
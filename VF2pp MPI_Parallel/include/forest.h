@@ -0,0 +1,118 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file forest.h
+ * @brief This file defines the isomorphism test of trees and forests, decided without any search by the AHU canonical labels,
+ *        and the labels of the trees hanging from the 2-core of a graph.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - vf2pp.h: Definition of the statistics of a search.
+ */
+
+#ifndef FOREST_H
+#define FOREST_H
+
+#include <stdbool.h>
+#include "graph.h"
+#include "vf2pp.h"
+
+/**
+ * @brief This function checks whether two graphs are isomorphic when the first one is a forest (m = n - c, without self loops).
+ *
+ * Every tree is rooted in its centre (or in the middle of its two centres) and the nodes of both graphs get the AHU labels, level
+ * by level from the leaves: two rooted subtrees have the same label exactly when they are isomorphic. The forests are isomorphic
+ * when their trees have the same multiset of labels; the mapping is built by matching the children with the same labels, from the roots.
+ * The time is O(n log n), due to the sorting of each level, instead of the exponential worst case of the search.
+ * When the graphs are isomorphic, the `mapped` field of each node of G1 (G2) contains its image in G2 (G1).
+ *
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param stats Pointer filled with the statistics (no states are explored), NULL if they are not needed.
+ * @return 1 if the graphs are isomorphic, 0 if they are not, -1 if G1 is not a forest (or the graphs have different sizes, or memory
+ *         cannot be allocated) and the search must be run instead.
+ */
+int forest_isomorphic(Graph* G1, Graph* G2, VF2ppStats* stats);
+
+/* Rooted trees of two graphs, labeled together (see forest.c) */
+struct RootedForests;
+
+/**
+ * @struct HangingTrees
+ * @brief This structure contains the trees hanging from the 2-cores of two graphs: the nodes removed by repeatedly removing the nodes of degree 1.
+ *
+ * @var HangingTrees::core1
+ * True for the nodes of G1 in its 2-core.
+ * @var HangingTrees::core2
+ * True for the nodes of G2 in its 2-core.
+ * @var HangingTrees::label1
+ * AHU label of the tree hanging from each node of G1, rooted in the node (the node alone when nothing hangs from it).
+ * @var HangingTrees::label2
+ * AHU label of the tree hanging from each node of G2; equal labels mean isomorphic rooted trees, also between the two graphs.
+ * @var HangingTrees::forests
+ * Rooted trees used to map the removed nodes.
+ */
+typedef struct {
+    bool* core1;
+    bool* core2;
+    const int* label1;
+    const int* label2;
+    struct RootedForests* forests;
+} HangingTrees;
+
+/**
+ * @brief This function removes the nodes of degree 1 from both graphs, until only their 2-cores are left, and labels the removed trees.
+ *
+ * Every removed node hangs from the neighbor left when it was removed: the trees are rooted in the nodes of the 2-cores.
+ * The labels are computed as in forest_isomorphic, in O(n log n) time.
+ *
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph, with the same number of nodes as `G1`.
+ * @param trees Pointer to the trees to be filled.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool find_hanging_trees(Graph* G1, Graph* G2, HangingTrees* trees);
+
+/**
+ * @brief This function extends a mapping of the 2-cores to the whole graphs, mapping the trees hanging from every pair of mapped nodes.
+ *
+ * @param trees Pointer to the trees of the graphs.
+ * @param G1 Pointer to G1 graph: the `mapped` field of each node of its 2-core contains a node of G2 with the same label.
+ * @param G2 Pointer to G2 graph.
+ */
+void map_hanging_trees(const HangingTrees* trees, Graph* G1, Graph* G2);
+
+/**
+ * @brief Frees up the memory allocated for the trees.
+ *
+ * @param trees Pointer to the trees to be freed.
+ */
+void free_hanging_trees(HangingTrees* trees);
+
+#endif // FOREST_H
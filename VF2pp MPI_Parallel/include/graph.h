@@ -51,6 +51,27 @@ Graph* createGraph(int num_nodes);
  */
 void freeGraph(Graph* g);
 
+/**
+ * @brief This function creates a copy of a graph, with the same nodes and neighbour lists
+ *
+ * @param g: the graph to be copied
+ *
+ * @return The created graph.
+ */
+Graph* copyGraph(Graph* g);
+
+/**
+ * @brief This function creates the complement of a graph: two distinct nodes are neighbours
+ *        in the complement exactly when they are not neighbours in the graph. The adjacency
+ *        bitsets of the graph are built (and cached) if needed, and those of the complement
+ *        are cached with it.
+ *
+ * @param g: the graph to be complemented
+ *
+ * @return The created graph, or NULL if the memory cannot be allocated.
+ */
+Graph* complementGraph(Graph* g);
+
 /**
  * @brief This function create the neighbour list of a node
  *
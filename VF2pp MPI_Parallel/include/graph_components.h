@@ -28,6 +28,7 @@
 #define VF2PP_GRAPH_COMPONENTS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /* Base graphs structures */
 /**
@@ -44,16 +45,25 @@ typedef struct{
     int mapped;
 }Node;
 
+/* Data computed on demand and cached with the graph (see symmetry.h) */
+struct Symmetry;
+
 /**
  * @brief Struct that defines the Graph
  *
  * @var num_nodes:  total number of nodes presents in the graph
  * @var nodes:      list containing all the nodes presents in the graph
+ * @var symmetry:   automorphisms and orbits of the graph, NULL until they are computed
+ * @var adjacency:  adjacency matrix as one bitset per node (see bitset.h), NULL until it is built
+ * @var signature:  structural signature of each node (see signature.h), NULL until it is computed
 
  */
 typedef struct{
     int num_nodes;
     Node* nodes;
+    struct Symmetry* symmetry;
+    uint64_t* adjacency;
+    uint64_t* signature;
 }Graph;
 
 #endif //VF2PP_GRAPH_COMPONENTS_H
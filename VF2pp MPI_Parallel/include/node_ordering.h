@@ -23,7 +23,7 @@
  *
  * You should have received a copy of the GNU General Public License along with ContestOMP. 
  * If not, see <http://www.gnu.org/licenses/>.
- */s
+ */
 /**
  *
  * @file node_ordering.h
@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include "graph.h"
 
 /**
@@ -51,10 +52,13 @@
  * Index of the node in the array `g->nodes`.
  * @var Context::node
  * Pointer to the node structure.
+ * @var Context::tiebreak
+ * Rank of the node among the nodes with its degree: 0 for every node unless the order is randomized (see matching_order_seeded).
  */
 typedef struct {
     int node_index; 
     Node* node;      
+    uint64_t tiebreak;
 } Context;
 
 /**
@@ -101,7 +105,19 @@ typedef struct {
 void matching_order(Graph* G1, int* node_order);
 
 /**
- * @brief Comparison function used to sort an array of `Context` structures. Sorts the nodes in ascending order with respect to the number of neighbors.
+ * @brief This function determines the order of the nodes in a graph 'G1', breaking the ties between nodes of equal degree at random.
+ *
+ * The root of each BFS is a node of maximum degree chosen by a hash of the seed and the node, and the nodes of equal degree in a
+ * level are sorted by the same hash, so that each seed gives a different order with the same structure as matching_order.
+ *
+ * @param G1 Pointer to graph.
+ * @param node_order Array that will be populated with the order of the nodes.
+ * @param seed Seed of the tie-breaking; 0 gives the order of matching_order.
+ */
+void matching_order_seeded(Graph* G1, int* node_order, uint64_t seed);
+
+/**
+ * @brief Comparison function used to sort an array of `Context` structures. Sorts the nodes in descending order with respect to the number of neighbors, then in ascending order of `tiebreak`.
  *
  * @param a Pointer to the first `Context` element.
  * @param b Pointer to the second `Context` element..
@@ -0,0 +1,183 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file nogood.h
+ * @brief This file defines the table of failed subproblems (nogoods) that the search records and checks before expanding a state.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ */
+
+#ifndef NOGOOD_H
+#define NOGOOD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+
+/* Number of entries of the table of nogoods (a power of two) and number of entries of each of its buckets */
+#define NOGOOD_TABLE_ENTRIES (1 << 16)
+#define NOGOOD_WAYS 4
+
+/**
+ * @struct Fingerprint
+ * @brief This structure contains the 128-bit fingerprint of a partial mapping: two independent 64-bit hashes.
+ *
+ * @var Fingerprint::a
+ * First hash, which also selects the bucket of the table.
+ * @var Fingerprint::b
+ * Second hash.
+ */
+typedef struct {
+    uint64_t a;
+    uint64_t b;
+} Fingerprint;
+
+/**
+ * @struct NogoodTable
+ * @brief This structure implements a bounded set-associative table of fingerprints, with clock eviction in each bucket.
+ *
+ * A fingerprint can only go to the NOGOOD_WAYS entries of its bucket. When they are all used, the clock hand of the bucket skips
+ * (and clears the reference bit of) the entries found by a lookup since it last passed them, and evicts the first one that was not:
+ * the nogoods that keep pruning the search stay in the table. Each search owns its table, so no lock is needed.
+ *
+ * @var NogoodTable::num_buckets
+ * Number of buckets, a power of two.
+ * @var NogoodTable::entries
+ * Fingerprints of the table, NOGOOD_WAYS for each bucket; an empty entry is all zeros.
+ * @var NogoodTable::referenced
+ * Reference bit of each entry, set when a lookup finds it.
+ * @var NogoodTable::hand
+ * Clock hand of each bucket.
+ * @var NogoodTable::lookups
+ * Number of lookups.
+ * @var NogoodTable::hits
+ * Number of lookups that found their fingerprint.
+ */
+typedef struct {
+    int num_buckets;
+    Fingerprint* entries;
+    uint8_t* referenced;
+    uint8_t* hand;
+    long lookups;
+    long hits;
+} NogoodTable;
+
+/**
+ * @struct Nogoods
+ * @brief This structure contains the nogoods of a search with a fixed node order, and the fingerprint of the current partial mapping at each depth.
+ *
+ * The nodes of G1 mapped at depth d are always the first d nodes of the order. What is left to search only depends on the set of the
+ * images (which nodes of G2 are still free) and on the images of the mapped nodes with an unmapped neighbor (the boundary): every
+ * other mapped node has all its neighbors mapped, so it constrains nothing but the set of images. The fingerprint of a depth hashes
+ * these two parts, so two partial mappings with the same fingerprint are the same subproblem: when one fails, the other one fails too.
+ * Both hashes are sums (XOR) of one term per image and one per boundary pair, so the fingerprint of the next depth is computed
+ * from the current one in time proportional to the boundary nodes that change.
+ *
+ * @var Nogoods::table
+ * Fingerprints of the failed subproblems.
+ * @var Nogoods::prefix
+ * Fingerprint of the partial mapping of each depth, from 0 to the number of nodes.
+ * @var Nogoods::last_depth
+ * Depth of the last neighbor of each node of G1 in the order (its own depth if all its neighbors come before it): the node is on the
+ * boundary from the depth after its own up to this one.
+ * @var Nogoods::closed_start
+ * Start in `closed` of the nodes whose last neighbor is matched at each depth.
+ * @var Nogoods::closed
+ * Nodes of G1 grouped by `last_depth`.
+ * @var Nogoods::recording
+ * False once a mapping has been found: the subproblems on its path do not fail, so nothing more is recorded.
+ */
+typedef struct {
+    NogoodTable table;
+    Fingerprint* prefix;
+    int* last_depth;
+    int* closed_start;
+    int* closed;
+    bool recording;
+} Nogoods;
+
+/**
+ * @brief This function allocates an empty table of nogoods and the fingerprints of the depths for a search of G1.
+ *
+ * @param nogoods Pointer to the nogoods to be initialized.
+ * @param G1 Pointer to G1 graph.
+ * @param node_order Order in which the nodes of G1 are matched.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool init_nogoods(Nogoods* nogoods, Graph* G1, const int* node_order);
+
+/**
+ * @brief Frees up the memory allocated for the nogoods.
+ *
+ * @param nogoods Pointer to the nogoods to be freed.
+ */
+void free_nogoods(Nogoods* nogoods);
+
+/**
+ * @brief This function computes the fingerprint of depth + 1 when the pair (u, v) is mapped at `depth`.
+ *
+ * @param nogoods Pointer to the nogoods.
+ * @param G1 Pointer to G1 graph, with the nodes of the previous depths mapped.
+ * @param depth Depth of the pair.
+ * @param u Node of G1 matched at `depth`.
+ * @param v Image of u.
+ */
+void extend_fingerprint(Nogoods* nogoods, Graph* G1, int depth, int u, int v);
+
+/**
+ * @brief This function checks whether the partial mapping of a depth is a subproblem that has already failed.
+ *
+ * @param nogoods Pointer to the nogoods.
+ * @param depth The depth, whose fingerprint has been computed.
+ * @return True if the fingerprint is in the table.
+ */
+bool is_nogood(Nogoods* nogoods, int depth);
+
+/**
+ * @brief This function records the partial mapping of a depth as a failed subproblem, unless a mapping has already been found.
+ *
+ * @param nogoods Pointer to the nogoods.
+ * @param depth The depth, whose fingerprint has been computed.
+ */
+void record_nogood(Nogoods* nogoods, int depth);
+
+/**
+ * @brief This function moves the table of failed subproblems of a search to another search, which gives its own table in exchange.
+ *
+ * The fingerprints do not depend on the search that computed them, so the move is sound when both searches match the same G1
+ * to the same G2 with the same node order: a subproblem that failed in one fails in the other. The counters of the lookups
+ * and hits move with the table.
+ *
+ * @param to Pointer to the nogoods that receive the table.
+ * @param from Pointer to the nogoods that give it.
+ */
+void transfer_nogoods(Nogoods* to, Nogoods* from);
+
+#endif // NOGOOD_H
@@ -0,0 +1,69 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file small_search.h
+ * @brief This file defines the VF2++ search specialized for graphs of at most 128 nodes, whose sets of nodes fit in one or two words.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - vf2pp.h: Definition of the options and the statistics of the search.
+ */
+
+#ifndef SMALL_SEARCH_H
+#define SMALL_SEARCH_H
+
+#include "graph.h"
+#include "vf2pp.h"
+
+/* Largest graphs searched by the specialized engine: the sets of nodes take one word up to 64 nodes, two words up to 128 */
+#define SMALL_SEARCH_MAX_NODES 128
+
+/**
+ * @brief This function checks whether two graphs are isomorphic with the VF2++ search specialized for small graphs.
+ *
+ * The engine is generated twice from include/small_search_template.h, for sets of nodes of one 64-bit word and of two words,
+ * and the one for the size of the graphs is chosen. Every adjacency row, the mapped nodes, T1, T2 and the candidates left at
+ * each depth are words kept on the stack, so the search loop is made of bitwise operations only, with no heap structure and no
+ * scan of the neighbor lists: the candidates of a node are the AND of the rows of the images of its mapped neighbors, the cut
+ * rules are popcounts of a row AND a set. It follows the matching order, the node keys, the complements of dense graphs and the
+ * cut rules of vf2pp_next, with chronological backtracking. When the graphs are isomorphic, the `mapped` field of each node of
+ * G1 (G2) contains its image in G2 (G1).
+ *
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param options Pointer to the options of the search, NULL for the default ones.
+ * @param stats Pointer filled with the statistics of the search, NULL if they are not needed.
+ * @return 1 if the graphs are isomorphic, 0 if they are not (or the budget of states ran out), -1 if G1 has more than
+ *         SMALL_SEARCH_MAX_NODES nodes, or an option that the engine does not implement is set (anything but the signatures and
+ *         the budget of states, the seed and the restarts included), or memory cannot be allocated for the matching order, and
+ *         the general search must be run.
+ */
+int small_isomorphic(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats);
+
+#endif // SMALL_SEARCH_H
@@ -30,24 +30,29 @@
  * @brief This file defines the data structures and functions to manage the stack that stores a node's candidates in order to keep track of mappings .
  */
 
+#ifndef STACK_H
+#define STACK_H
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 
 /**
  * @struct NodeCandidates
- * @brief That structure represents a node and its candidates.
+ * @brief That structure represents a node and the scan of its candidates, which are found one at a time when they are tried.
  *
  * @field node The index of the current node extracted from the node order.
- * @field candidates A dynamic array containing the indexes of candidate nodes.
- * @field flags A dynamic array of Boolean flags, one for each candidate, to indicate the status (validity) of the candidate.
- * @field num_candidates The total number of valid candidates associated with the node.
+ * @field pivot How the candidates are found (see find_candidates.h); unused when they are scanned in the domain of the node
+ *              (see domains.h).
+ * @field cursor The position of the scan: the candidates before it have already been tried.
+ * @field rank The rank of the last candidate tried, when the candidates are tried by rank (see value_order.h): the candidates
+ *             tried are the ones with a smaller rank, or with the same rank and a position before the cursor.
  */
 typedef struct {
     int node;            
-    int* candidates;    
-    bool* flags;         
-    int num_candidates;  
+    int pivot;    
+    int cursor;         
+    long rank;
 } NodeCandidates;
 
 /**
@@ -68,8 +73,9 @@ typedef struct {
  * @brief This function initializes a dynamic stack to store objects of type NodeCandidates.
  *
  * @param stack Pointer to the stack to be initialized.
+ * @param capacity The initial capacity: a search reserves one element per node, so that the stack never grows.
  */
-void init_stack(Stack* stack);
+void init_stack(Stack* stack, int capacity);
 
 /**
  * @brief This function dynamically resizes the stack to increase its capacity.
@@ -79,13 +85,6 @@ void init_stack(Stack* stack);
  */
 void resize_stack(Stack* stack, int new_capacity);
 
-/**
- * @brief This function dynamically reduces the stack capacity to free unused memory.
- *
- * @param stack Pointer to the stack to be reduced.
- */
-void shrink_stack(Stack* stack);
-
 /**
  * @brief This function adds a new element to the top of the stack.
  *
@@ -111,8 +110,10 @@ NodeCandidates pop(Stack* stack);
 NodeCandidates peek(Stack* stack);
 
 /**
- * @brief Frees up memory allocated for the stack and its elements.
+ * @brief Frees up memory allocated for the stack.
  *
  * @param stack Pointer to the stack to be freed.
  */
-void free_stack(Stack* stack);
\ No newline at end of file
+void free_stack(Stack* stack);
+
+#endif // STACK_H
@@ -0,0 +1,139 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file value_order.h
+ * @brief This file defines the strategies that choose the order in which the candidates of a node are tried.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ */
+
+#ifndef VALUE_ORDER_H
+#define VALUE_ORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+
+/* Strategies of VF2ppOptions::value_order */
+/* The candidates are tried in the order they are found (see find_candidates.h) */
+#define VALUE_ORDER_SCAN 0
+/* The candidates in the refined class of the node first, then the candidates in the rarest refined classes */
+#define VALUE_ORDER_RAREST 1
+/* The candidates with as many unmapped nodes at distance two as the node first, then the ones with the fewest */
+#define VALUE_ORDER_UNMAPPED 2
+/* The image of the node in a mapping found before (the hint) first */
+#define VALUE_ORDER_LEARNED 3
+/* The candidates in the order of a hash of the seed, the node and the candidate: a different random order for every seed */
+#define VALUE_ORDER_RANDOM 4
+
+/**
+ * @struct ValueRanks
+ * @brief This structure contains what the strategies need to rank the candidates v of a node u: the smaller the rank, the sooner
+ *        v is tried. Every rank but the random one is an invariant of the pair that is equal for u and its image in any
+ *        isomorphism; the candidates whose count disagrees with the one of u come after the others, so the order never discards a
+ *        candidate.
+ *
+ * The refined class of a node hashes its key (its signature when both graphs have one, its degree otherwise) with the multiset
+ * of the keys of its neighbors: one round of color refinement beyond the class that the candidates share with u.
+ *
+ * @var ValueRanks::strategy
+ * One of the VALUE_ORDER_* strategies.
+ * @var ValueRanks::class1
+ * Refined class of each node of G1 (VALUE_ORDER_RAREST).
+ * @var ValueRanks::class2
+ * Refined class of each node of G2 (VALUE_ORDER_RAREST).
+ * @var ValueRanks::class_size
+ * Number of nodes of G2 in the refined class of each node of G2 (VALUE_ORDER_RAREST).
+ * @var ValueRanks::hint
+ * Image of each node of G1 in the mapping learned before, -1 when it is unknown (VALUE_ORDER_LEARNED).
+ * @var ValueRanks::seed
+ * Seed of the random order (VALUE_ORDER_RANDOM).
+ */
+typedef struct {
+    int strategy;
+    uint64_t* class1;
+    uint64_t* class2;
+    int* class_size;
+    int* hint;
+    uint64_t seed;
+} ValueRanks;
+
+/**
+ * @brief This function prepares the ranks of a strategy for the search between G1 and G2.
+ *
+ * @param ranks Pointer to the structure to be initialized.
+ * @param strategy One of the VALUE_ORDER_* strategies, other than VALUE_ORDER_SCAN.
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param hint Image in G2 of each node of G1 in a mapping found before, used by VALUE_ORDER_LEARNED; the images out of range
+ *             are ignored.
+ * @param hint_nodes Number of elements of `hint`: the hint is used only when it is the number of nodes of G1, so it is ignored
+ *                   by the searches of subgraphs (see core.h, components.h, twins.h).
+ * @param seed Seed of VALUE_ORDER_RANDOM.
+ * @return True on success, false if memory cannot be allocated or VALUE_ORDER_LEARNED has no usable hint.
+ */
+bool init_value_ranks(ValueRanks* ranks, int strategy, Graph* G1, Graph* G2, const int* hint, int hint_nodes, uint64_t seed);
+
+/**
+ * @brief Frees up the memory allocated for the ranks.
+ *
+ * @param ranks Pointer to the structure to be freed.
+ */
+void free_value_ranks(ValueRanks* ranks);
+
+/**
+ * @brief This function ranks a candidate of an unmapped node, from the current mapping (the `mapped` fields of the graphs).
+ *
+ * @param ranks Pointer to the ranks.
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param u Unmapped node of G1.
+ * @param v Candidate of `u`, unmapped node of G2.
+ * @return The rank of `v`, not negative: the candidates are tried by ascending rank.
+ */
+long candidate_rank(const ValueRanks* ranks, Graph* G1, Graph* G2, int u, int v);
+
+/**
+ * @brief This function returns the name of a strategy, as written on the command line.
+ *
+ * @param strategy One of the VALUE_ORDER_* strategies.
+ * @return "scan", "rarest", "unmapped", "learned" or "random".
+ */
+const char* value_order_name(int strategy);
+
+/**
+ * @brief This function finds the strategy with a given name.
+ *
+ * @param name Name of the strategy, as returned by `value_order_name`.
+ * @return The strategy, -1 if no strategy has that name.
+ */
+int value_order_from_name(const char* name);
+
+#endif // VALUE_ORDER_H
@@ -0,0 +1,192 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file arc_consistency.c
+ * @brief This file contains the sweeps that filter the initial domains of the nodes of G1 by neighborhood arc consistency.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - bitset.h: Definition of the bitsets of the domains and of the supports.
+ * - find_candidates.h: Definition of the classes of the nodes.
+ * - domains.h: Defines the domains filtered.
+ * - arc_consistency.h: Declares the filtering.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "graph.h"
+#include "bitset.h"
+#include "find_candidates.h"
+#include "domains.h"
+#include "arc_consistency.h"
+
+/**
+ * Writes to `support` the OR of the adjacency bitsets of G2 of the nodes in `set`; returns how many bitsets were ORed.
+ */
+static long _support(uint64_t* support, const uint64_t* set, const uint64_t* adjacency2, int words) {
+    long work = 0;
+    memset(support, 0, words * sizeof(uint64_t));
+    for (int i = 0; i < words; i++) {
+        for (uint64_t word = set[i]; word != 0; word &= word - 1) {
+            const uint64_t* row = adjacency2 + (size_t)(i * BITSET_WORD_BITS + bitset_lowest_bit(word)) * words;
+            for (int j = 0; j < words; j++) {
+                support[j] |= row[j];
+            }
+            work++;
+        }
+    }
+    return work;
+}
+
+/**
+ * ANDs the domain of u with the supports of its neighbors, word by word. Returns 1 if the domain changed, 2 if it is now empty,
+ * 0 otherwise.
+ */
+static int _filter_node(Domains* domains, Graph* G1, const uint64_t* const* support, int u) {
+    int words = domains->words;
+    uint64_t* domain = domains->bits + (size_t)u * words;
+    bool changed = false, empty = true;
+    for (int j = 0; j < words; j++) {
+        uint64_t word = domain[j];
+        for (int i = 0; i < G1->nodes[u].num_neighbors && word != 0; i++) {
+            word &= support[G1->nodes[u].neighborhood[i]][j];
+        }
+        changed = changed || (word != domain[j]);
+        empty = empty && (word == 0);
+        domain[j] = word;
+    }
+    return empty ? 2 : (changed ? 1 : 0);
+}
+
+/**
+ * 1. Rejects at once a node of G1 whose class has no node of G2, and computes the support of every class.
+ * 2. Sweeps until the fixpoint or the work limit: filters every node with a neighbor whose support changed (_filter_node),
+ *    stopping if a domain is emptied, then recomputes the support of every node whose domain changed (_support).
+ * 3. Checks that every node of G2 is still in some domain, and saves the domains as the initial ones.
+ */
+bool arc_consistency(Domains* domains, Graph* G1, const CandidateFilter* filter, const uint64_t* adjacency2) {
+    int n = domains->num_nodes;
+    int words = domains->words;
+    int num_classes = 0;
+    for (int u = 0; u < n; u++) {
+        if (filter->node_class[u] == -1) {
+            return false;
+        }
+        if (filter->node_class[u] >= num_classes) {
+            num_classes = filter->node_class[u] + 1;
+        }
+    }
+    uint64_t* class_support = (uint64_t*)malloc((size_t)num_classes * words * sizeof(uint64_t));
+    uint64_t* node_support = (uint64_t*)malloc((size_t)n * words * sizeof(uint64_t));
+    const uint64_t** support = (const uint64_t**)malloc(n * sizeof(uint64_t*));
+    char* dirty = (char*)malloc(n * sizeof(char));
+    char* changed = (char*)malloc(n * sizeof(char));
+    if (class_support == NULL || node_support == NULL || support == NULL || dirty == NULL || changed == NULL) {
+        free(class_support);
+        free(node_support);
+        free(support);
+        free(dirty);
+        free(changed);
+        return true;
+    }
+    long work = 0;
+    for (int c = 0; c < num_classes; c++) {
+        work += _support(class_support + (size_t)c * words, filter->class_bits + (size_t)c * words, adjacency2, words);
+    }
+    for (int u = 0; u < n; u++) {
+        support[u] = class_support + (size_t)filter->node_class[u] * words;
+        dirty[u] = 1;
+    }
+
+    bool consistent = true;
+    long max_work = (long)ARC_CONSISTENCY_MAX_WORK * n;
+    while (consistent) {
+        int any_changed = 0, any_empty = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) reduction(||:any_changed,any_empty)
+#endif
+        for (int u = 0; u < n; u++) {
+            changed[u] = 0;
+            bool check = false;
+            for (int i = 0; i < G1->nodes[u].num_neighbors && !check; i++) {
+                check = dirty[G1->nodes[u].neighborhood[i]];
+            }
+            if (check) {
+                int result = _filter_node(domains, G1, support, u);
+                changed[u] = (result != 0);
+                any_changed = any_changed || (result != 0);
+                any_empty = any_empty || (result == 2);
+            }
+        }
+        if (any_empty) {
+            consistent = false;
+            break;
+        }
+        if (!any_changed || work > max_work) {
+            break;
+        }
+        long sweep_work = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:sweep_work)
+#endif
+        for (int u = 0; u < n; u++) {
+            dirty[u] = changed[u];
+            if (changed[u]) {
+                sweep_work += _support(node_support + (size_t)u * words, domains->bits + (size_t)u * words, adjacency2, words);
+                support[u] = node_support + (size_t)u * words;
+            }
+        }
+        work += sweep_work;
+    }
+
+    if (consistent) {
+        uint64_t* covered = class_support; // the supports of the classes are no longer needed
+        memset(covered, 0, words * sizeof(uint64_t));
+        for (int u = 0; u < n; u++) {
+            for (int j = 0; j < words; j++) {
+                covered[j] |= domains->bits[(size_t)u * words + j];
+            }
+        }
+        consistent = bitset_count(covered, words) == n;
+    }
+    if (consistent) {
+        domains->initial = node_support;
+        memcpy(domains->initial, domains->bits, (size_t)n * words * sizeof(uint64_t));
+    } else {
+        free(node_support);
+    }
+    free(class_support);
+    free(support);
+    free(dirty);
+    free(changed);
+    return consistent;
+}
@@ -0,0 +1,158 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file backjump.c
+ * @brief This file contains the functions that manage the conflict sets of conflict-directed backjumping.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - backjump.h: Defines the conflict sets.
+ * - bitset.h: Definition of the bitsets that store the conflict sets.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitset.h"
+#include "backjump.h"
+
+/**
+ * Allocates the triangle of bitsets (depth d needs the bits of the depths 0..d-1), the inverse of the node order and the depths
+ * at which the nodes of G2 enter T2.
+ */
+bool init_conflict_sets(ConflictSets* conflicts, const int* node_order, int num_nodes) {
+    memset(conflicts, 0, sizeof(ConflictSets));
+    conflicts->num_depths = num_nodes;
+    conflicts->offset = (size_t*)malloc((num_nodes + 1) * sizeof(size_t));
+    conflicts->depth_of = (int*)malloc(num_nodes * sizeof(int));
+    conflicts->entered = (int*)malloc(num_nodes * sizeof(int));
+    conflicts->full = (bool*)calloc(num_nodes, sizeof(bool));
+    conflicts->scratch = (int*)malloc(num_nodes * sizeof(int));
+    if (conflicts->offset == NULL || conflicts->depth_of == NULL || conflicts->entered == NULL || conflicts->full == NULL
+        || conflicts->scratch == NULL) {
+        free_conflict_sets(conflicts);
+        return false;
+    }
+    size_t total = 0;
+    for (int d = 0; d < num_nodes; d++) {
+        conflicts->offset[d] = total;
+        total += bitset_words(d);
+        conflicts->depth_of[node_order[d]] = d;
+        conflicts->entered[d] = -1;
+    }
+    conflicts->offset[num_nodes] = total;
+    conflicts->bits = (uint64_t*)calloc(total + 1, sizeof(uint64_t));
+    if (conflicts->bits == NULL) {
+        free_conflict_sets(conflicts);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Frees every array of the conflict sets.
+ */
+void free_conflict_sets(ConflictSets* conflicts) {
+    free(conflicts->offset);
+    free(conflicts->bits);
+    free(conflicts->full);
+    free(conflicts->depth_of);
+    free(conflicts->entered);
+    free(conflicts->scratch);
+    memset(conflicts, 0, sizeof(ConflictSets));
+}
+
+/**
+ * Clears the words of the set of `depth`.
+ */
+void clear_conflict_set(ConflictSets* conflicts, int depth) {
+    uint64_t* set = conflicts->bits + conflicts->offset[depth];
+    memset(set, 0, bitset_words(depth) * sizeof(uint64_t));
+    conflicts->full[depth] = false;
+}
+
+/**
+ * Sets the bits 0..depth-1: the full words, then the low bits of the last one.
+ */
+void add_all_conflicts(ConflictSets* conflicts, int depth) {
+    if (conflicts->full[depth]) {
+        return;
+    }
+    conflicts->full[depth] = true;
+    uint64_t* set = conflicts->bits + conflicts->offset[depth];
+    int full = depth / BITSET_WORD_BITS;
+    for (int i = 0; i < full; i++) {
+        set[i] = ~(uint64_t)0;
+    }
+    if (depth % BITSET_WORD_BITS != 0) {
+        set[full] |= ((uint64_t)1 << (depth % BITSET_WORD_BITS)) - 1;
+    }
+}
+
+/**
+ * Sets the bits 0..last: the full words, then the low bits of the last one; when `last` is the depth just below, the set is full.
+ */
+void add_conflict_prefix(ConflictSets* conflicts, int depth, int last) {
+    if (last >= depth - 1) {
+        add_all_conflicts(conflicts, depth);
+        return;
+    }
+    uint64_t* set = conflicts->bits + conflicts->offset[depth];
+    int full = (last + 1) / BITSET_WORD_BITS;
+    for (int i = 0; i < full; i++) {
+        set[i] = ~(uint64_t)0;
+    }
+    if ((last + 1) % BITSET_WORD_BITS != 0) {
+        set[full] |= ((uint64_t)1 << ((last + 1) % BITSET_WORD_BITS)) - 1;
+    }
+}
+
+/**
+ * 1. Finds the highest bit of the set of `depth`, scanning its words from the last one.
+ * 2. Clears it and ORs the rest of the set into the set of that depth: the failure of `depth` is now a failure of the assignment
+ *    made there, caused by the same earlier assignments. A full set leaves a full set.
+ */
+int conflict_jump(ConflictSets* conflicts, int depth) {
+    uint64_t* set = conflicts->bits + conflicts->offset[depth];
+    int words = bitset_words(depth);
+    int target = -1;
+    for (int i = words - 1; i >= 0 && target == -1; i--) {
+        if (set[i] != 0) {
+            target = i * BITSET_WORD_BITS + bitset_highest_bit(set[i]);
+        }
+    }
+    if (target == -1) {
+        return -1;
+    }
+    bitset_clear(set, target);
+    uint64_t* target_set = conflicts->bits + conflicts->offset[target];
+    for (int i = 0; i < bitset_words(target); i++) {
+        target_set[i] |= set[i];
+    }
+    conflicts->full[target] = conflicts->full[target] || conflicts->full[depth];
+    return target;
+}
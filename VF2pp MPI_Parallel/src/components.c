@@ -0,0 +1,516 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "bitset.h"
+#include "find_candidates.h"
+#include "heap_counter.h"
+#include "components.h"
+
+/**
+ * Visits the graph breadth-first from every node not visited yet; each visit is a component.
+ * The queue of the visit is `nodes` itself: the nodes of a component are appended after those of the previous ones.
+ * When the graph is small enough for the adjacency bitsets (the same ones used by the search) and dense enough that a bitset has
+ * fewer words than a neighbor list has elements on average, the neighbors not visited yet of a node are found a word at a time,
+ * ANDing its bitset with the bitset of the unvisited nodes; otherwise its neighbor list is scanned.
+ */
+bool find_components(Graph* g, Components* components) {
+    int n = g->num_nodes;
+    int words = bitset_words(n);
+    long degree_sum = 0;
+    for(int u = 0; u < n; u++){
+        degree_sum += g->nodes[u].num_neighbors;
+    }
+    bool dense = degree_sum >= (long)n * words;
+    const uint64_t* adjacency = (dense && n <= CANDIDATE_BITSET_MAX_NODES) ? graph_adjacency(g) : NULL;
+    uint64_t* unvisited = (adjacency != NULL) ? bitset_alloc(n) : NULL;
+    if(unvisited == NULL){
+        adjacency = NULL;
+    }
+    components->num_components = 0;
+    components->component = (int*)malloc(n * sizeof(int));
+    components->local = (int*)malloc(n * sizeof(int));
+    components->start = (int*)malloc((n + 1) * sizeof(int));
+    components->nodes = (int*)malloc(n * sizeof(int));
+    if(components->component == NULL || components->local == NULL || components->start == NULL || components->nodes == NULL){
+        fprintf(stderr, "ERROR: components allocation error");
+        free_components(components);
+        free(unvisited);
+        return false;
+    }
+    for(int i = 0; i < n; i++){
+        components->component[i] = -1;
+        if(unvisited != NULL){
+            bitset_set(unvisited, i);
+        }
+    }
+
+    int tail = 0;
+    for(int root = 0; root < n; root++){
+        if(components->component[root] != -1){
+            continue;
+        }
+        int k = components->num_components++;
+        int head = tail;
+        components->start[k] = head;
+        components->component[root] = k;
+        components->nodes[tail++] = root;
+        if(unvisited != NULL){
+            bitset_clear(unvisited, root);
+        }
+        while(head < tail){
+            int u = components->nodes[head];
+            components->local[u] = head - components->start[k];
+            head++;
+            if(adjacency != NULL){
+                const uint64_t* row = adjacency + (size_t)u * words;
+                for(int w = 0; w < words; w++){
+                    uint64_t reached = row[w] & unvisited[w];
+                    unvisited[w] &= ~reached;
+                    while(reached != 0){
+                        int v = w * BITSET_WORD_BITS + bitset_lowest_bit(reached);
+                        reached &= reached - 1;
+                        components->component[v] = k;
+                        components->nodes[tail++] = v;
+                    }
+                }
+                continue;
+            }
+            for(int i = 0; i < g->nodes[u].num_neighbors; i++){
+                int v = g->nodes[u].neighborhood[i];
+                if(components->component[v] == -1){
+                    components->component[v] = k;
+                    components->nodes[tail++] = v;
+                }
+            }
+        }
+    }
+    components->start[components->num_components] = n;
+    free(unvisited);
+    return true;
+}
+
+/**
+ * Frees the arrays of the components; the structure itself is not freed.
+ */
+void free_components(Components* components) {
+    free(components->component);
+    free(components->local);
+    free(components->start);
+    free(components->nodes);
+    components->component = NULL;
+    components->local = NULL;
+    components->start = NULL;
+    components->nodes = NULL;
+    components->num_components = 0;
+}
+
+/**
+ * Copies the neighbor lists of the nodes of the component, translating every neighbor to its local index.
+ * The lists are copied in place (the neighbors of a node are all in its component), so the subgraph has the same neighbor order.
+ */
+Graph* component_graph(Graph* g, const Components* components, int k) {
+    int first = components->start[k];
+    int size = components->start[k + 1] - first;
+    Graph* sub = createGraph(size);
+    if(sub == NULL || sub->nodes == NULL){
+        fprintf(stderr, "ERROR: component graph allocation error");
+        free(sub);
+        return NULL;
+    }
+    for(int i = 0; i < size; i++){
+        Node* node = &g->nodes[components->nodes[first + i]];
+        if(node->num_neighbors == 0){
+            continue;
+        }
+        int* list = (int*)malloc(node->num_neighbors * sizeof(int));
+        if(list == NULL){
+            fprintf(stderr, "ERROR: component graph allocation error");
+            freeGraph(sub);
+            return NULL;
+        }
+        for(int j = 0; j < node->num_neighbors; j++){
+            list[j] = components->local[node->neighborhood[j]];
+        }
+        sub->nodes[i].neighborhood = list;
+        sub->nodes[i].num_neighbors = node->num_neighbors;
+    }
+    return sub;
+}
+
+/**
+ * Invariants of a component: two isomorphic components have the same ones.
+ */
+typedef struct {
+    int size;
+    long degree_sum;
+    unsigned long long degree_squares;
+    int index;
+} ComponentInvariant;
+
+static void component_invariants(Graph* g, const Components* components, ComponentInvariant* invariants) {
+    for(int k = 0; k < components->num_components; k++){
+        ComponentInvariant* inv = &invariants[k];
+        inv->size = components->start[k + 1] - components->start[k];
+        inv->degree_sum = 0;
+        inv->degree_squares = 0;
+        inv->index = k;
+        for(int i = components->start[k]; i < components->start[k + 1]; i++){
+            unsigned long long degree = g->nodes[components->nodes[i]].num_neighbors;
+            inv->degree_sum += degree;
+            inv->degree_squares += degree * degree;
+        }
+    }
+}
+
+static int compare_invariants(const ComponentInvariant* a, const ComponentInvariant* b) {
+    if(a->size != b->size) return (a->size < b->size) ? -1 : 1;
+    if(a->degree_sum != b->degree_sum) return (a->degree_sum < b->degree_sum) ? -1 : 1;
+    if(a->degree_squares != b->degree_squares) return (a->degree_squares < b->degree_squares) ? -1 : 1;
+    return 0;
+}
+
+static int compare_components(const void* a, const void* b) {
+    const ComponentInvariant* x = (const ComponentInvariant*)a;
+    const ComponentInvariant* y = (const ComponentInvariant*)b;
+    int cmp = compare_invariants(x, y);
+    if(cmp != 0) return cmp;
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+/* Values of the memo of a pair of components */
+#define PAIR_UNKNOWN 0
+#define PAIR_ISOMORPHIC 1
+#define PAIR_DIFFERENT 2
+
+/**
+ * Data shared by the searches of the pairs of components.
+ * The components are referred to by their position in the sorted invariants: the components of a class (same invariants) are the
+ * positions [class_start[p], class_end[p]) in both graphs, and the memo of the class is a square matrix starting at memo_offset[p].
+ */
+typedef struct {
+    Graph* G1;
+    Graph* G2;
+    const Components* c1;
+    const Components* c2;
+    const ComponentInvariant* inv1;
+    const ComponentInvariant* inv2;
+    const VF2ppOptions* options;
+    int* class_start;
+    int* class_end;
+    size_t* memo_offset;
+    unsigned char* memo;
+    int* image;
+} ComponentMatching;
+
+static unsigned char* pair_memo(ComponentMatching* m, int p, int q) {
+    int s = m->class_end[p] - m->class_start[p];
+    return &m->memo[m->memo_offset[p] + (size_t)(p - m->class_start[p]) * s + (q - m->class_start[p])];
+}
+
+/**
+ * Checks the components at positions p (G1) and q (G2) on private copies, so that pairs of components can be checked in parallel;
+ * each pair goes through vf2pp_is_isomorphic_with_options, so a tree is decided by its labels and only the 2-core of any other
+ * component is searched. When they are isomorphic, the image in G2 of each node of the G1 component is written in `image`.
+ * The result is memoized; -1 is returned if the copies cannot be allocated.
+ */
+static int match_pair(ComponentMatching* m, int p, int q, VF2ppStats* total) {
+    int a = m->inv1[p].index;
+    int b = m->inv2[q].index;
+    Graph* A = component_graph(m->G1, m->c1, a);
+    Graph* B = component_graph(m->G2, m->c2, b);
+    if(A == NULL || B == NULL){
+        if(A != NULL) freeGraph(A);
+        if(B != NULL) freeGraph(B);
+        return -1;
+    }
+    VF2ppStats stats;
+    bool isIso = vf2pp_is_isomorphic_with_options(A, B, m->options, &stats);
+    total->num_states += stats.num_states;
+    total->heap_calls += stats.heap_calls;
+    total->nogood_lookups += stats.nogood_lookups;
+    total->nogood_hits += stats.nogood_hits;
+    total->first_choices += stats.first_choices;
+    total->endgames += stats.endgames;
+    total->fallbacks += stats.fallbacks;
+    total->restarts += stats.restarts;
+    if(stats.value_order > total->value_order){
+        total->value_order = stats.value_order;
+    }
+    if(isIso){
+        int first1 = m->c1->start[a];
+        int first2 = m->c2->start[b];
+        for(int i = 0; i < A->num_nodes; i++){
+            m->image[m->c1->nodes[first1 + i]] = m->c2->nodes[first2 + A->nodes[i].mapped];
+        }
+    }
+    *pair_memo(m, p, q) = isIso ? PAIR_ISOMORPHIC : PAIR_DIFFERENT;
+    freeGraph(A);
+    freeGraph(B);
+    return isIso ? 1 : 0;
+}
+
+/**
+ * Matches the components of the graphs, once their invariants are sorted:
+ * 1. Graphs with different multisets of component invariants are not isomorphic. The components are sorted by invariants,
+ *    so the components that can be isomorphic form the same range (class) in both graphs.
+ * 2. Every component of G1 with more than one node is matched to the components of its class in G2, until an isomorphic one is found;
+ *    the components are independent, so they are processed in parallel (with OpenMP). The i-th component of a class starts from the
+ *    i-th one of G2, so that classes of isomorphic components usually need a single search for each component.
+ *    A component of G1 without any isomorphic component in G2 means that the graphs are not isomorphic.
+ * 3. The partners are then chosen sequentially, so that each component of G2 is used once. Since isomorphism is an equivalence,
+ *    choosing any free isomorphic partner never prevents a complete matching. When the partner found in step 2 is already used by a
+ *    component A', the component is isomorphic to A' and inherits the results memoized for A'; only the pairs still unknown are searched.
+ *    The components with a single node are matched by position.
+ * Returns 1 when every component has a partner (the images are in `image`), 0 when the graphs are not isomorphic, -1 on allocation errors.
+ */
+static int match_components(ComponentMatching* m, int k, int* found, int* owner, VF2ppStats* total) {
+    const ComponentInvariant* inv1 = m->inv1;
+    const ComponentInvariant* inv2 = m->inv2;
+
+    // 1. Compare the invariants and build the classes
+    size_t memo_size = 0;
+    for(int p = 0; p < k; p++){
+        if(compare_invariants(&inv1[p], &inv2[p]) != 0){
+            return 0;
+        }
+        if(p > 0 && compare_invariants(&inv1[p - 1], &inv1[p]) == 0){
+            continue;
+        }
+        int end = p + 1;
+        while(end < k && compare_invariants(&inv1[p], &inv1[end]) == 0){
+            end++;
+        }
+        for(int q = p; q < end; q++){
+            m->class_start[q] = p;
+            m->class_end[q] = end;
+            m->memo_offset[q] = memo_size;
+        }
+        if(inv1[p].size > 1){
+            memo_size += (size_t)(end - p) * (end - p);
+        }
+    }
+    m->memo = (unsigned char*)calloc(memo_size > 0 ? memo_size : 1, 1);
+    if(m->memo == NULL){
+        fprintf(stderr, "ERROR: component matching allocation error");
+        return -1;
+    }
+
+    // 2. Search a partner for every component, in parallel
+    long states = 0;
+    long calls = 0;
+    long lookups = 0;
+    long hits = 0;
+    long first_choices = 0;
+    long endgames = 0;
+    long fallbacks = 0;
+    long restarts = 0;
+    int value_order = VALUE_ORDER_SCAN;
+    bool failed = false;
+    bool missing = false;
+#ifdef _OPENMP
+    bitset_init_kernels();
+    #pragma omp parallel for schedule(dynamic) reduction(+:states,calls,lookups,hits,first_choices,endgames,fallbacks,restarts) reduction(max:value_order) reduction(||:failed,missing)
+#endif
+    for(int p = 0; p < k; p++){
+        found[p] = -1;
+        if(inv1[p].size == 1){
+            continue;
+        }
+        int lo = m->class_start[p];
+        int s = m->class_end[p] - lo;
+        for(int t = 0; t < s && found[p] == -1 && !failed; t++){
+            int q = lo + (p - lo + t) % s;
+            VF2ppStats pair_stats = {0, 0, 0, 0, VALUE_ORDER_SCAN, 0, 0, 0, 0};
+            int isIso = match_pair(m, p, q, &pair_stats);
+            states += pair_stats.num_states;
+            calls += pair_stats.heap_calls;
+            lookups += pair_stats.nogood_lookups;
+            hits += pair_stats.nogood_hits;
+            first_choices += pair_stats.first_choices;
+            endgames += pair_stats.endgames;
+            fallbacks += pair_stats.fallbacks;
+            restarts += pair_stats.restarts;
+            if(pair_stats.value_order > value_order){
+                value_order = pair_stats.value_order;
+            }
+            if(isIso < 0){
+                failed = true;
+            }else if(isIso){
+                found[p] = q;
+            }
+        }
+        if(found[p] == -1){
+            missing = true;
+        }
+    }
+    total->num_states += states;
+    total->heap_calls += calls;
+    total->nogood_lookups += lookups;
+    total->nogood_hits += hits;
+    total->first_choices += first_choices;
+    total->endgames += endgames;
+    total->fallbacks += fallbacks;
+    total->restarts += restarts;
+    if(value_order > total->value_order){
+        total->value_order = value_order;
+    }
+    if(failed){
+        return -1;
+    }
+    if(missing){
+        return 0;
+    }
+
+    // 3. Choose a distinct partner for every component
+    for(int q = 0; q < k; q++){
+        owner[q] = -1;
+    }
+    for(int p = 0; p < k; p++){
+        if(inv1[p].size == 1){
+            m->image[m->c1->nodes[m->c1->start[inv1[p].index]]] = m->c2->nodes[m->c2->start[inv2[p].index]];
+            continue;
+        }
+        int lo = m->class_start[p];
+        int s = m->class_end[p] - lo;
+        int partner = found[p];
+        if(owner[partner] != -1){
+            int other = owner[partner];
+            for(int q = lo; q < lo + s; q++){
+                if(*pair_memo(m, p, q) == PAIR_UNKNOWN){
+                    *pair_memo(m, p, q) = *pair_memo(m, other, q);
+                }
+            }
+            partner = -1;
+            for(int t = 0; t < s && partner == -1; t++){
+                int q = lo + (p - lo + t) % s;
+                if(owner[q] != -1 || *pair_memo(m, p, q) == PAIR_DIFFERENT){
+                    continue;
+                }
+                // The search is run even when the pair is known to be isomorphic, to compute its images
+                int isIso = match_pair(m, p, q, total);
+                if(isIso < 0){
+                    return -1;
+                }
+                if(isIso){
+                    partner = q;
+                }
+            }
+            if(partner == -1){
+                return 0;
+            }
+        }
+        owner[partner] = p;
+    }
+    return 1;
+}
+
+/**
+ * Finds the components of both graphs: a connected G1 is left to a single search. Graphs with different numbers of components
+ * are not isomorphic; otherwise the invariants of the components are sorted and the components are matched (match_components).
+ * When they all have a partner, the images are copied in the `mapped` fields of the graphs.
+ * The statistics are the sum of those of every search run.
+ */
+int vf2pp_components_isomorphic(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats) {
+    int n = G1->num_nodes;
+    if(n == 0 || n != G2->num_nodes){
+        return -1;
+    }
+    Components c1, c2;
+    if(!find_components(G1, &c1)){
+        return -1;
+    }
+    if(c1.num_components == 1){
+        free_components(&c1);
+        return -1;
+    }
+    if(!find_components(G2, &c2)){
+        free_components(&c1);
+        return -1;
+    }
+
+    int k = c1.num_components;
+    ComponentInvariant* inv1 = (ComponentInvariant*)malloc(k * sizeof(ComponentInvariant));
+    ComponentInvariant* inv2 = (ComponentInvariant*)malloc(k * sizeof(ComponentInvariant));
+    ComponentMatching m;
+    m.G1 = G1;
+    m.G2 = G2;
+    m.c1 = &c1;
+    m.c2 = &c2;
+    m.inv1 = inv1;
+    m.inv2 = inv2;
+    m.options = options;
+    m.class_start = (int*)malloc(k * sizeof(int));
+    m.class_end = (int*)malloc(k * sizeof(int));
+    m.memo_offset = (size_t*)malloc(k * sizeof(size_t));
+    m.memo = NULL;
+    m.image = (int*)malloc(n * sizeof(int));
+    int* found = (int*)malloc(k * sizeof(int));
+    int* owner = (int*)malloc(k * sizeof(int));
+
+    int result = -1;
+    VF2ppStats total = {0, 0, 0, 0, VALUE_ORDER_SCAN, 0, 0, 0, 0};
+    if(inv1 == NULL || inv2 == NULL || m.class_start == NULL || m.class_end == NULL || m.memo_offset == NULL
+       || m.image == NULL || found == NULL || owner == NULL){
+        fprintf(stderr, "ERROR: component matching allocation error");
+    }else if(c2.num_components != k){
+        result = 0;
+    }else{
+        component_invariants(G1, &c1, inv1);
+        component_invariants(G2, &c2, inv2);
+        qsort(inv1, k, sizeof(ComponentInvariant), compare_components);
+        qsort(inv2, k, sizeof(ComponentInvariant), compare_components);
+        result = match_components(&m, k, found, owner, &total);
+    }
+
+    if(result == 1){
+        for(int u = 0; u < n; u++){
+            G1->nodes[u].mapped = m.image[u];
+            G2->nodes[m.image[u]].mapped = u;
+        }
+    }
+    if(stats != NULL && result >= 0){
+        *stats = total;
+        if(heap_calls() < 0){
+            stats->heap_calls = -1;
+        }
+    }
+    free(inv1);
+    free(inv2);
+    free(m.class_start);
+    free(m.class_end);
+    free(m.memo_offset);
+    free(m.memo);
+    free(m.image);
+    free(found);
+    free(owner);
+    free_components(&c1);
+    free_components(&c2);
+    return result;
+}
@@ -0,0 +1,220 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file domains.c
+ * @brief This file contains the functions that narrow the domains of the nodes of G1 and undo the changes.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - bitset.h: Definition of the bitsets that store the domains.
+ * - dynamic_order.h: Defines the keys updated with the domains.
+ * - domains.h: Defines the domains and their trail.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "graph.h"
+#include "bitset.h"
+#include "dynamic_order.h"
+#include "domains.h"
+
+/**
+ * Allocates the domains, the trail and the levels, and copies the class of every node to its domain (which stays empty when no
+ * node of G2 is in the class).
+ */
+bool init_domains(Domains* domains, Graph* G1, const CandidateFilter* filter) {
+    int n = G1->num_nodes;
+    int words = filter->words;
+    memset(domains, 0, sizeof(Domains));
+    domains->num_nodes = n;
+    domains->words = words;
+    domains->trail_capacity = n * words;
+    domains->bits = (uint64_t*)calloc((size_t)n * words, sizeof(uint64_t));
+    domains->trail = (DomainChange*)malloc((size_t)domains->trail_capacity * sizeof(DomainChange));
+    domains->levels = (DomainLevel*)malloc(n * sizeof(DomainLevel));
+    if (domains->bits == NULL || domains->trail == NULL || domains->levels == NULL) {
+        free_domains(domains);
+        return false;
+    }
+    for (int u = 0; u < n; u++) {
+        if (filter->node_class[u] != -1) {
+            memcpy(domains->bits + (size_t)u * words, filter->class_bits + (size_t)filter->node_class[u] * words, words * sizeof(uint64_t));
+        }
+    }
+    return true;
+}
+
+/**
+ * Frees every array of the structure.
+ */
+void free_domains(Domains* domains) {
+    free(domains->bits);
+    free(domains->initial);
+    free(domains->trail);
+    free(domains->levels);
+    memset(domains, 0, sizeof(Domains));
+}
+
+/**
+ * Opens the level of the pair, takes u out of the dynamic order, then ANDs the domain of each unmapped neighbor w of u with the
+ * neighbors of v, pushing every word changed on the trail (or marking the level as overflowed when the trail is full). With the
+ * dynamic order, the key of w becomes the number of its candidates (domain AND T2). Stops at the first neighbor left without
+ * candidates.
+ */
+int narrow_domains(Domains* domains, Graph* G1, const uint64_t* adjacency2, int u, int v, const uint64_t* T2, DynamicOrder* order) {
+    int words = domains->words;
+    const uint64_t* row2 = adjacency2 + (size_t)v * words;
+    DomainLevel* level = &domains->levels[domains->depth++];
+    level->trail_start = domains->trail_size;
+    level->overflow = false;
+    if (order != NULL) {
+        set_node_key(order, u, INT_MAX);
+    }
+    for (int i = 0; i < G1->nodes[u].num_neighbors; i++) {
+        int w = G1->nodes[u].neighborhood[i];
+        if (G1->nodes[w].mapped != -1) {
+            continue;
+        }
+        size_t start = (size_t)w * words;
+        uint64_t* domain = domains->bits + start;
+        uint64_t candidates = 0;
+        for (int j = 0; j < words; j++) {
+            uint64_t narrowed = domain[j] & row2[j];
+            if (narrowed != domain[j]) {
+                if (domains->trail_size < domains->trail_capacity) {
+                    domains->trail[domains->trail_size].index = start + j;
+                    domains->trail[domains->trail_size].bits = domain[j];
+                    domains->trail_size++;
+                } else {
+                    level->overflow = true;
+                }
+                domain[j] = narrowed;
+            }
+            candidates |= narrowed & T2[j];
+        }
+        if (order != NULL) {
+            set_node_key(order, w, (candidates == 0) ? 0 : bitset_and_count(domain, T2, words));
+        }
+        if (candidates == 0) {
+            return w;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Recomputes the domain of the unmapped node w: its initial domain ANDed with the neighbors of the images of its mapped neighbors.
+ */
+static void _recompute_domain(Domains* domains, Graph* G1, const CandidateFilter* filter, const uint64_t* adjacency2, int w) {
+    int words = domains->words;
+    uint64_t* domain = domains->bits + (size_t)w * words;
+    if (filter->node_class[w] == -1) {
+        memset(domain, 0, words * sizeof(uint64_t));
+        return;
+    }
+    const uint64_t* initial = (domains->initial != NULL) ? domains->initial + (size_t)w * words
+                                                         : filter->class_bits + (size_t)filter->node_class[w] * words;
+    memcpy(domain, initial, words * sizeof(uint64_t));
+    for (int j = 0; j < G1->nodes[w].num_neighbors; j++) {
+        int image = G1->nodes[G1->nodes[w].neighborhood[j]].mapped;
+        if (image != -1) {
+            bitset_and(domain, adjacency2 + (size_t)image * words, words);
+        }
+    }
+}
+
+/**
+ * Closes the level of the pair: writes back the words pushed on the trail since the level was opened, in reverse order, or, when
+ * the trail overflowed, drops them and recomputes the domain of each unmapped neighbor of u (_recompute_domain).
+ * With the dynamic order, the keys of u and of its unmapped neighbors are recomputed: the number of candidates in T1, the key of
+ * T1_tilde otherwise. The domain of u did not change while it was mapped.
+ */
+void restore_domains(Domains* domains, Graph* G1, const CandidateFilter* filter, const uint64_t* adjacency2, int u, const uint64_t* T1, const uint64_t* T2, DynamicOrder* order) {
+    int words = domains->words;
+    DomainLevel* level = &domains->levels[--domains->depth];
+    if (level->overflow) {
+        domains->trail_size = level->trail_start;
+        for (int i = 0; i < G1->nodes[u].num_neighbors; i++) {
+            int w = G1->nodes[u].neighborhood[i];
+            if (G1->nodes[w].mapped == -1) {
+                _recompute_domain(domains, G1, filter, adjacency2, w);
+            }
+        }
+    } else {
+        while (domains->trail_size > level->trail_start) {
+            const DomainChange* change = &domains->trail[--domains->trail_size];
+            domains->bits[change->index] = change->bits;
+        }
+    }
+    if (order == NULL) {
+        return;
+    }
+    for (int i = 0; i < G1->nodes[u].num_neighbors; i++) {
+        int w = G1->nodes[u].neighborhood[i];
+        if (G1->nodes[w].mapped == -1) {
+            set_node_key(order, w, bitset_test(T1, w) ? bitset_and_count(domains->bits + (size_t)w * words, T2, words) : order->tilde_key[w]);
+        }
+    }
+    set_node_key(order, u, bitset_test(T1, u) ? bitset_and_count(domains->bits + (size_t)u * words, T2, words) : order->tilde_key[u]);
+}
+
+/**
+ * Pushes the word of v in the domain of u on the trail, in the level of the last pair mapped, then clears the bit of v.
+ */
+bool remove_domain_value(Domains* domains, int u, int v) {
+    if (domains->depth == 0 || domains->levels[domains->depth - 1].overflow || domains->trail_size == domains->trail_capacity) {
+        return false;
+    }
+    size_t index = (size_t)u * domains->words + v / BITSET_WORD_BITS;
+    domains->trail[domains->trail_size].index = index;
+    domains->trail[domains->trail_size].bits = domains->bits[index];
+    domains->trail_size++;
+    domains->bits[index] &= ~(1ULL << (v % BITSET_WORD_BITS));
+    return true;
+}
+
+/**
+ * Scans the words of domain AND pool from the one of `from`, masking the bits below `from` in the first one.
+ */
+int next_domain_candidate(const Domains* domains, int u, const uint64_t* pool, int from) {
+    if (from >= domains->num_nodes) {
+        return -1;
+    }
+    const uint64_t* domain = domains->bits + (size_t)u * domains->words;
+    int i = from / BITSET_WORD_BITS;
+    uint64_t word = domain[i] & pool[i] & (~0ULL << (from % BITSET_WORD_BITS));
+    while (word == 0) {
+        if (++i == domains->words) {
+            return -1;
+        }
+        word = domain[i] & pool[i];
+    }
+    return i * BITSET_WORD_BITS + bitset_lowest_bit(word);
+}
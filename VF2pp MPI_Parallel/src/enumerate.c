@@ -0,0 +1,207 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file enumerate.c
+ * @brief This file contains the functions used to enumerate or count all the mappings between two graphs, and a binary writer to stream the mappings to a file.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - enumerate.h: Definition of the enumeration options and of the binary writer.
+ * - vf2pp.h: Definition of the resumable VF2++ search.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vf2pp.h"
+#include "enumerate.h"
+
+/**
+ * Runs a single VF2++ search and keeps resuming it after each mapping found.
+ * Symmetry breaking is disabled, since it would skip the mappings equivalent to the ones already found, and so is the endgame,
+ * which ends the search at the first mapping it completes.
+ * 1. In count-only mode the mappings are not copied and the callback is not called.
+ * 2. Otherwise each mapping is copied in a buffer allocated once and passed to the callback; the callback can stop the enumeration returning false.
+ * 3. The enumeration also stops when `max_mappings` mappings have been found.
+ * Every node is left unmapped at the end, so the graphs can be used in other searches.
+ */
+long vf2pp_enumerate(Graph* G1, Graph* G2, const EnumerationOptions* options) {
+    VF2ppOptions search_options;
+    if(options->search != NULL){
+        search_options = *options->search;
+    }else{
+        vf2pp_default_options(&search_options);
+    }
+    search_options.symmetry_breaking = false;
+    search_options.endgame_threshold = 0;
+
+    VF2ppState* state = vf2pp_init(G1, G2, &search_options);
+    if(state == NULL){
+        return 0;
+    }
+
+    int* mapping = NULL;
+    if(!options->count_only){
+        mapping = (int*)malloc(G1->num_nodes * sizeof(int));
+        if(mapping == NULL){
+            fprintf(stderr, "ERROR: mapping allocation error");
+            vf2pp_free(state);
+            return 0;
+        }
+    }
+
+    long count = 0;
+    while(vf2pp_next(state, mapping)){
+        count++;
+        if(mapping != NULL && options->callback != NULL){
+            if(!options->callback(mapping, G1->num_nodes, options->user_data)){
+                break;
+            }
+        }
+        if(options->max_mappings > 0 && count >= options->max_mappings){
+            break;
+        }
+    }
+
+    vf2pp_free(state);
+    for(int i = 0; i < G1->num_nodes; i++){
+        G1->nodes[i].mapped = -1;
+        G2->nodes[i].mapped = -1;
+    }
+    free(mapping);
+    return count;
+}
+
+/**
+ * Creates the file and writes the header: the magic string, the number of nodes and a placeholder for the number of mappings,
+ * which is updated when the writer is closed.
+ */
+MappingWriter* mapping_writer_open(const char* filename, int num_nodes) {
+    FILE* file = fopen(filename, "wb");
+    if(file == NULL){
+        fprintf(stderr, "Failed to open mappings file");
+        return NULL;
+    }
+
+    MappingWriter* writer = (MappingWriter*)malloc(sizeof(MappingWriter));
+    if(writer == NULL){
+        fprintf(stderr, "ERROR: mapping writer allocation error");
+        fclose(file);
+        return NULL;
+    }
+    writer->file = file;
+    writer->num_nodes = num_nodes;
+    writer->count = 0;
+
+    int64_t unknown_count = -1;
+    if(fwrite(MAPPING_FILE_MAGIC, 1, 4, file) != 4 ||
+       fwrite(&writer->num_nodes, sizeof(int32_t), 1, file) != 1 ||
+       fwrite(&unknown_count, sizeof(int64_t), 1, file) != 1){
+        fprintf(stderr, "ERROR: mappings file header not written");
+        fclose(file);
+        free(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+/**
+ * Converts the mapping to int32 values and appends it to the file through the stdio buffer.
+ * A short buffer on the stack is reused to avoid an allocation for every mapping.
+ */
+bool mapping_writer_write(const int* mapping, int num_nodes, void* writer) {
+    MappingWriter* w = (MappingWriter*)writer;
+    if(num_nodes != w->num_nodes){
+        fprintf(stderr, "ERROR: mapping with %d nodes written in a file of %d nodes", num_nodes, w->num_nodes);
+        return false;
+    }
+
+    int32_t buffer[256];
+    for(int i = 0; i < num_nodes; i += 256){
+        int chunk = (num_nodes - i < 256) ? num_nodes - i : 256;
+        for(int j = 0; j < chunk; j++){
+            buffer[j] = (int32_t)mapping[i + j];
+        }
+        if(fwrite(buffer, sizeof(int32_t), chunk, w->file) != (size_t)chunk){
+            fprintf(stderr, "ERROR: mapping not written");
+            return false;
+        }
+    }
+    w->count++;
+    return true;
+}
+
+/**
+ * Writes the final number of mappings in the header when the file is seekable (otherwise it is left to -1), then closes the file.
+ */
+void mapping_writer_close(MappingWriter* writer) {
+    if(writer == NULL){
+        return;
+    }
+    if(fseek(writer->file, 4 + sizeof(int32_t), SEEK_SET) == 0){
+        fwrite(&writer->count, sizeof(int64_t), 1, writer->file);
+    }
+    fclose(writer->file);
+    free(writer);
+}
+
+/**
+ * Checks the magic and the number of nodes of the header, skips the number of mappings and converts the first mapping from
+ * int32 values.
+ */
+bool mapping_file_read(const char* filename, int num_nodes, int* mapping) {
+    FILE* file = fopen(filename, "rb");
+    if(file == NULL){
+        fprintf(stderr, "Failed to open mappings file");
+        return false;
+    }
+    char magic[4];
+    int32_t file_nodes = 0;
+    int64_t count = 0;
+    bool ok = fread(magic, 1, 4, file) == 4 && memcmp(magic, MAPPING_FILE_MAGIC, 4) == 0
+              && fread(&file_nodes, sizeof(int32_t), 1, file) == 1 && fread(&count, sizeof(int64_t), 1, file) == 1;
+    if(!ok){
+        fprintf(stderr, "ERROR: %s is not a mappings file\n", filename);
+    }else if(file_nodes != num_nodes){
+        fprintf(stderr, "ERROR: the mappings of %s have %d nodes, not %d\n", filename, (int)file_nodes, num_nodes);
+        ok = false;
+    }
+    int32_t buffer[256];
+    for(int i = 0; ok && i < num_nodes; i += 256){
+        int chunk = (num_nodes - i < 256) ? num_nodes - i : 256;
+        if(fread(buffer, sizeof(int32_t), chunk, file) != (size_t)chunk){
+            fprintf(stderr, "ERROR: %s contains no mapping\n", filename);
+            ok = false;
+        }
+        for(int j = 0; j < chunk; j++){
+            mapping[i + j] = (int)buffer[j];
+        }
+    }
+    fclose(file);
+    return ok;
+}
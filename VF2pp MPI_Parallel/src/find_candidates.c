@@ -33,145 +33,213 @@
  * This module depends on the following files:
  * - find_candidates.h: Defines functions to find nodes of G2 that are candidates to be mapped to a node of G1.
  * - graph.h: Definition of graph structure.
+ * - bitset.h: Definition of the bitsets used to intersect the neighborhoods.
+ * - signature.h: Definition of the structural signatures of the nodes.
  */
 
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 #include "graph.h"
+#include "bitset.h"
+#include "signature.h"
 #include "find_candidates.h"
 
 /**
- * This function finds candidate nodes in a G2 graph that could match a specific node u in another G1 graph.
- * The goal is to support matching algorithms between graphs.
- * 
- * 1. Identification of mapped neighbors:
- *    Searches the neighbors of u in G1 for those already mapped to nodes in G2.
- *    It collects them in a temporary covered_neighbords array.
- * 
- * 2. Case 1: No neighbors mapped:
- *    If none of the neighbors are mapped, considers all nodes in G2 that are not already mapped, are in T2_tilde, and have the same degree of u.
- *    
- * 3. Case 2: Only one neighbor mapped:
- *    Check the neighbors of the mapped node in G2 and select those that are not already mapped and have the same degree of u.
- * 
- * 4. Case 3: Multiple neighbors mapped:
- *    It uses an algorithm to find nodes in G2 that are common among the neighbors of all mapped nodes. 
- *    It filters these nodes based on the criteria of mapping and degree. 
- *    Sort the neighbors of each mapped node using qsort to optimize the comparison.
- * 
- * 5. Memory release:
- *    Frees up temporary memory (covered_neighbords) to prevent leakage.
+ * Returns the key that a node must share with its candidates: its signature when both graphs have their signatures
+ * (see graph_signatures), its degree otherwise. The signature includes the degree, so it is the stronger filter.
  */
-int* _find_candidates(int u, Graph* G1, Graph* G2, int* size_candidates, bool* T2_tilde){
-    Node* covered_neighbords = (Node*) malloc(G1->nodes[u].num_neighbors * sizeof(Node));
-    int num_nodes = 0;
+static uint64_t _node_key(Graph* g, int v, bool signatures){
+    return signatures ? g->signature[v] : (uint64_t)g->nodes[v].num_neighbors;
+}
 
+/**
+ * Counts the mapped neighbors of u and picks the image with the smallest degree as the pivot: a node of G2 adjacent to the images
+ * of all the mapped neighbors is among its neighbors. With several mapped neighbors and the bitsets of `filter`, the candidates
+ * are computed word by word instead.
+ */
+int candidate_pivot(int u, Graph* G1, Graph* G2, const CandidateFilter* filter){
+    int num_covered = 0;
+    int pivot = PIVOT_NONE;
     for(int i=0; i<G1->nodes[u].num_neighbors; i++){
-        int nbr = G1->nodes[u].neighborhood[i];
-        int mapping = G1->nodes[nbr].mapped;
+        int mapping = G1->nodes[G1->nodes[u].neighborhood[i]].mapped;
         if(mapping != -1){
-            covered_neighbords[num_nodes++] = G2->nodes[mapping];
+            num_covered++;
+            if(pivot == PIVOT_NONE || G2->nodes[mapping].num_neighbors < G2->nodes[pivot].num_neighbors){
+                pivot = mapping;
+            }
         }
     }
+    return (num_covered > 1 && filter != NULL) ? PIVOT_BITSETS : pivot;
+}
 
-    if(num_nodes == 0){
-        int* candidates = (int*)malloc(G2->num_nodes * sizeof(int));
-        for(int i=0; i<G2->num_nodes; i++){
-            if((G2->nodes[i].mapped == -1) && (T2_tilde[i]==true) && (G2->nodes[i].num_neighbors == G1->nodes[u].num_neighbors))
-                candidates[num_nodes++] = i;
+/**
+ * Checks whether the node x of G2 is adjacent to the images of all the mapped neighbors of u but the pivot, scanning the
+ * neighbor list of each image (or testing its adjacency bitset, with the bitsets of `filter`).
+ */
+static bool _adjacent_to_images(int u, int pivot, int x, Graph* G1, Graph* G2, const CandidateFilter* filter){
+    for(int i=0; i<G1->nodes[u].num_neighbors; i++){
+        int image = G1->nodes[G1->nodes[u].neighborhood[i]].mapped;
+        if(image == -1 || image == pivot){
+            continue;
+        }
+        if(filter != NULL){
+            if(!bitset_test(filter->adjacency + (size_t)image * filter->words, x)){
+                return false;
+            }
+            continue;
         }
-        *size_candidates = num_nodes;
-        for (int i = 0; i < G1->nodes[u].num_neighbors; i++) {
-            covered_neighbords[i].neighborhood = NULL;
+        bool common = false;
+        for(int j=0; j<G2->nodes[image].num_neighbors && !common; j++){
+            common = (G2->nodes[image].neighborhood[j] == x);
+        }
+        if(!common){
+            return false;
         }
-        free(covered_neighbords);
-        return candidates;
     }
+    return true;
+}
 
-    else{
+/**
+ * This function finds the next candidate in a G2 graph that could match a specific node u in another G1 graph, resuming the scan
+ * from the cursor, so that a search that accepts one of the first candidates never computes the others.
+ * 
+ * 1. Case 1: No neighbors mapped (PIVOT_NONE):
+ *    Considers the nodes of G2 from the cursor on that are in T2_tilde (so not already mapped) and have the same key
+ *    (signature, or degree when the signatures have not been computed) of u.
+ *    With the bitsets of `filter`, they are the bits of T2_tilde AND the bitset of the class of u.
+ * 
+ * 2. Case 2: Several neighbors mapped, with the bitsets of `filter` (PIVOT_BITSETS):
+ *    Computes the words of T2 (every candidate is an unmapped neighbor of a mapped node) AND the bitset of the class of u AND the
+ *    adjacency bitset of every image, from the word of the cursor on, stopping at the first word that is not empty; the cursor
+ *    is a node of G2, so the candidates come in ascending order.
+ * 
+ * 3. Case 3: Otherwise, the cursor is a position in the neighbors of the pivot:
+ *    Scans them from the cursor on and selects those that are not already mapped, have the same key of u and are in the
+ *    neighborhood of all the other images (_adjacent_to_images).
+ */
+int next_candidate(int u, int pivot, int* cursor, Graph* G1, Graph* G2, const uint64_t* T2, const uint64_t* T2_tilde, const CandidateFilter* filter){
+    bool signatures = G1->signature != NULL && G2->signature != NULL;
+    uint64_t key = _node_key(G1, u, signatures);
 
-        if(num_nodes  == 1){
-            int* candidates = (int*)malloc(covered_neighbords[0].num_neighbors* sizeof(int));
-            int num_candidates = 0;
-            *size_candidates = num_candidates;
-            int node = G1->nodes[covered_neighbords[0].mapped].mapped;
-            for(int i =0; i<covered_neighbords[0].num_neighbors; i++ ){
-                int candidate = G2->nodes[node].neighborhood[i];
-                if(((G2->nodes[candidate].num_neighbors == G1->nodes[u].num_neighbors) && (G2->nodes[candidate].mapped == -1))){
-                    candidates[num_candidates++] = candidate;
+    if(pivot == PIVOT_NONE || pivot == PIVOT_BITSETS){
+        int n = G2->num_nodes;
+        if(filter == NULL){
+            for(int i=*cursor; i<n; i++){
+                if(bitset_test(T2_tilde, i) && (_node_key(G2, i, signatures) == key)){
+                    *cursor = i + 1;
+                    return i;
                 }
             }
-            *size_candidates = num_candidates;
-            for (int i = 0; i < G1->nodes[u].num_neighbors; i++) {
-                covered_neighbords[i].neighborhood = NULL;
-            }
-            free(covered_neighbords);
-            return candidates;
+            *cursor = n;
+            return -1;
         }
-        else{
-            int max_dim=0;
-            for(int c=0; c<num_nodes; c++){
-              max_dim += covered_neighbords[c].num_neighbors;
-            }
-            int* candidates = (int*)malloc( max_dim* sizeof(int));
-            int num_candidates = 0;
-            *size_candidates = num_candidates;
-            qsort(covered_neighbords, num_nodes, sizeof(Node), comparator);
-            bool found = false; int count = 0;
-            int size_covered_neighbor_0 = covered_neighbords[0].num_neighbors;
-            for(int elem = 0; elem< size_covered_neighbor_0; elem++){
-                count=0;
-                int node = covered_neighbords[0].neighborhood[elem];
-                if(!((G2->nodes[node].num_neighbors == G1->nodes[u].num_neighbors) && (G2->nodes[node].mapped == -1))){
-                    continue;
-                }
-
-                for(int i=1; i < num_nodes; i++){
-                    for(int j=0; j<covered_neighbords[i].num_neighbors; j++){
-                        if(node == covered_neighbords[i].neighborhood[j]){
-                            found = true;
-                            count++;
-                            break;
-                        }
-                    }
-                    if(found){
-                        found = false;
-                        continue;
-                    }else{
-                        break;
-                    }
-                }
-                if (count == num_nodes -1 ){
-                    candidates[num_candidates++] = node;
-                    *size_candidates = num_candidates;
+        int node_class = filter->node_class[u];
+        if(node_class == -1 || *cursor >= n){
+            *cursor = n;
+            return -1;
+        }
+        const uint64_t* class_bits = filter->class_bits + (size_t)node_class * filter->words;
+        const uint64_t* pool = (pivot == PIVOT_NONE) ? T2_tilde : T2;
+        uint64_t mask = ~0ULL << (*cursor % BITSET_WORD_BITS);
+        for(int i = *cursor / BITSET_WORD_BITS; i < filter->words; i++, mask = ~0ULL){
+            uint64_t word = pool[i] & class_bits[i] & mask;
+            for(int j=0; j<G1->nodes[u].num_neighbors && word != 0 && pivot == PIVOT_BITSETS; j++){
+                int image = G1->nodes[G1->nodes[u].neighborhood[j]].mapped;
+                if(image != -1){
+                    word &= filter->adjacency[(size_t)image * filter->words + i];
                 }
             }
-            for (int i = 0; i < G1->nodes[u].num_neighbors; i++) {
-                covered_neighbords[i].neighborhood = NULL;
+            if(word != 0){
+                int candidate = i * BITSET_WORD_BITS + bitset_lowest_bit(word);
+                *cursor = candidate + 1;
+                return candidate;
             }
-            free(covered_neighbords);
-            return candidates;
         }
+        *cursor = n;
+        return -1;
+    }
 
+    Node* covered = &G2->nodes[pivot];
+    for(int i=*cursor; i<covered->num_neighbors; i++){
+        int candidate = covered->neighborhood[i];
+        if((_node_key(G2, candidate, signatures) == key) && (G2->nodes[candidate].mapped == -1)
+           && _adjacent_to_images(u, pivot, candidate, G1, G2, filter)){
+            *cursor = i + 1;
+            return candidate;
+        }
     }
+    *cursor = covered->num_neighbors;
+    return -1;
+}
 
+/**
+ * Compares two keys, for qsort and bsearch.
+ */
+static int _compare_keys(const void* a, const void* b){
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
 }
 
 /**
- * This function compares two nodes based on their degree (number of neighbors). 
- * It is used by qsort to sort an array of nodes.
- * 
- * 1. It receives two generic pointers a and b representing nodes.
- * 2. It converts these pointers to nodes (Node*) and compares the number of neighbors (num_neighbors).
- * 3. Returns: 
- *    A negative value if node1 has fewer neighbors than node2.
- *    Zero if they have the same number of neighbors.
- *    A positive value if node1 has more neighbors than node2.
+ * Builds the bitsets of the filter:
+ * 1. Gets the adjacency bitsets cached with G2 (building them the first time).
+ * 2. Sorts the distinct keys of the nodes of G2 (signatures when both graphs have them, degrees otherwise): the position of a key
+ *    is the index of its class.
+ * 3. Sets the bit of each node of G2 in the bitset of its class, and finds the class of each node of G1 with a binary search.
  */
-int comparator(const void* a, const void* b) {
-    const Node* node1 = *(const Node**)a;
-    const Node* node2 = *(const Node**)b;
+bool init_candidate_filter(CandidateFilter* filter, Graph* G1, Graph* G2){
+    memset(filter, 0, sizeof(CandidateFilter));
+    if(G2->num_nodes > CANDIDATE_BITSET_MAX_NODES){
+        return false;
+    }
+    int n = G2->num_nodes;
+    bool signatures = G1->signature != NULL && G2->signature != NULL;
+    filter->words = bitset_words(n);
+    filter->adjacency = graph_adjacency(G2);
+    filter->node_class = (int*)malloc(G1->num_nodes * sizeof(int));
+    uint64_t* keys = (uint64_t*)malloc(n * sizeof(uint64_t));
+    if(filter->adjacency == NULL || filter->node_class == NULL || keys == NULL){
+        free(keys);
+        free_candidate_filter(filter);
+        return false;
+    }
+    for(int v=0; v<n; v++){
+        keys[v] = _node_key(G2, v, signatures);
+    }
+    qsort(keys, n, sizeof(uint64_t), _compare_keys);
+    int num_classes = 0;
+    for(int i=0; i<n; i++){
+        if(i == 0 || keys[i] != keys[num_classes - 1]){
+            keys[num_classes++] = keys[i];
+        }
+    }
+    filter->class_bits = (uint64_t*)calloc((size_t)num_classes * filter->words, sizeof(uint64_t));
+    if(filter->class_bits == NULL){
+        free(keys);
+        free_candidate_filter(filter);
+        return false;
+    }
+    for(int v=0; v<n; v++){
+        uint64_t key = _node_key(G2, v, signatures);
+        const uint64_t* found = (const uint64_t*)bsearch(&key, keys, num_classes, sizeof(uint64_t), _compare_keys);
+        bitset_set(filter->class_bits + (size_t)(found - keys) * filter->words, v);
+    }
+    for(int u=0; u<G1->num_nodes; u++){
+        uint64_t key = _node_key(G1, u, signatures);
+        const uint64_t* found = (const uint64_t*)bsearch(&key, keys, num_classes, sizeof(uint64_t), _compare_keys);
+        filter->node_class[u] = (found != NULL) ? (int)(found - keys) : -1;
+    }
+    free(keys);
+    return true;
+}
 
-    return node1->num_neighbors - node2->num_neighbors;
+/**
+ * Frees the bitsets owned by the filter.
+ */
+void free_candidate_filter(CandidateFilter* filter){
+    free(filter->node_class);
+    free(filter->class_bits);
+    memset(filter, 0, sizeof(CandidateFilter));
 }
@@ -0,0 +1,611 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "components.h"
+#include "forest.h"
+
+/**
+ * Child of a rooted node, with the label of its subtree.
+ */
+typedef struct {
+    int label;
+    int node;
+} LabeledChild;
+
+/**
+ * Node of a level, compared by its children's labels to compute its own label.
+ */
+typedef struct {
+    int node;
+    bool virtual_root;
+    int num_children;
+    const LabeledChild* children;
+} LevelEntry;
+
+/**
+ * The nodes of both forests rooted together, so that their labels can be compared: the node u of G1 is u, the node v of G2 is
+ * n + v, and the roots added in the middle of two centres come after them.
+ * `stack` (2 * size elements) is a scratch buffer: the queue of find_centres and the stack of map_forests.
+ */
+typedef struct RootedForests {
+    int n;
+    int size;
+    int* parent;
+    int* order;
+    int* height;
+    int* child_start;
+    LabeledChild* children;
+    int* label;
+    int* roots;
+    int num_roots1;
+    int num_roots2;
+    int* stack;
+} RootedForests;
+
+/**
+ * Allocates the arrays of `size` nodes (2n plus the added roots) and `num_roots` roots; every node starts without a parent (-2).
+ */
+static bool alloc_rooted_forests(RootedForests* forests, int n, int size, int num_roots) {
+    forests->n = n;
+    forests->size = size;
+    forests->num_roots1 = 0;
+    forests->num_roots2 = 0;
+    forests->parent = (int*)malloc(size * sizeof(int));
+    forests->order = (int*)malloc(size * sizeof(int));
+    forests->height = (int*)malloc(size * sizeof(int));
+    forests->child_start = (int*)malloc((size + 1) * sizeof(int));
+    forests->children = (LabeledChild*)malloc((size + 1) * sizeof(LabeledChild));
+    forests->label = (int*)malloc(size * sizeof(int));
+    forests->roots = (int*)malloc((num_roots + 1) * sizeof(int));
+    forests->stack = (int*)malloc(2 * (size_t)size * sizeof(int));
+    if(forests->parent == NULL || forests->order == NULL || forests->height == NULL || forests->child_start == NULL
+       || forests->children == NULL || forests->label == NULL || forests->roots == NULL || forests->stack == NULL){
+        fprintf(stderr, "ERROR: forest allocation error");
+        return false;
+    }
+    for(int x = 0; x < size; x++){
+        forests->parent[x] = -2;
+    }
+    return true;
+}
+
+static void free_rooted_forests(RootedForests* forests) {
+    free(forests->parent);
+    free(forests->order);
+    free(forests->height);
+    free(forests->child_start);
+    free(forests->children);
+    free(forests->label);
+    free(forests->roots);
+    free(forests->stack);
+}
+
+static int compare_labeled_children(const void* a, const void* b) {
+    const LabeledChild* x = (const LabeledChild*)a;
+    const LabeledChild* y = (const LabeledChild*)b;
+    if(x->label != y->label) return (x->label < y->label) ? -1 : 1;
+    return (x->node > y->node) - (x->node < y->node);
+}
+
+static int compare_level_entries(const void* a, const void* b) {
+    const LevelEntry* x = (const LevelEntry*)a;
+    const LevelEntry* y = (const LevelEntry*)b;
+    if(x->virtual_root != y->virtual_root) return x->virtual_root ? 1 : -1;
+    if(x->num_children != y->num_children) return (x->num_children < y->num_children) ? -1 : 1;
+    for(int i = 0; i < x->num_children; i++){
+        if(x->children[i].label != y->children[i].label){
+            return (x->children[i].label < y->children[i].label) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Sorts the children of a node by label: most nodes of a tree have few children, sorted in place without calling qsort.
+ */
+static void sort_children(LabeledChild* children, int num_children) {
+    if(num_children > 16){
+        qsort(children, num_children, sizeof(LabeledChild), compare_labeled_children);
+        return;
+    }
+    for(int i = 1; i < num_children; i++){
+        LabeledChild child = children[i];
+        int j = i - 1;
+        while(j >= 0 && compare_labeled_children(&children[j], &child) > 0){
+            children[j + 1] = children[j];
+            j--;
+        }
+        children[j + 1] = child;
+    }
+}
+
+/**
+ * A graph is a forest when it has no self loops and exactly n - c edges, c being the number of its connected components.
+ */
+static bool is_forest(Graph* g, const Components* components) {
+    long degree_sum = 0;
+    for(int u = 0; u < g->num_nodes; u++){
+        for(int i = 0; i < g->nodes[u].num_neighbors; i++){
+            if(g->nodes[u].neighborhood[i] == u){
+                return false;
+            }
+        }
+        degree_sum += g->nodes[u].num_neighbors;
+    }
+    return degree_sum == 2L * (g->num_nodes - components->num_components);
+}
+
+/**
+ * Finds the centres of the k-th tree, removing its leaves layer by layer until one or two nodes are left; `degree` and `queue`
+ * are scratch arrays of n elements. Returns the number of centres.
+ */
+static int find_centres(Graph* g, const Components* components, int k, int* degree, int* queue, int* centres) {
+    int first = components->start[k];
+    int size = components->start[k + 1] - first;
+    if(size <= 2){
+        for(int i = 0; i < size; i++){
+            centres[i] = components->nodes[first + i];
+        }
+        return size;
+    }
+    int head = 0, tail = 0;
+    for(int i = first; i < first + size; i++){
+        int u = components->nodes[i];
+        degree[u] = g->nodes[u].num_neighbors;
+        if(degree[u] == 1){
+            queue[tail++] = u;
+        }
+    }
+    int remaining = size;
+    while(remaining > 2){
+        int layer_end = tail;
+        remaining -= layer_end - head;
+        for(; head < layer_end; head++){
+            int u = queue[head];
+            for(int i = 0; i < g->nodes[u].num_neighbors; i++){
+                int v = g->nodes[u].neighborhood[i];
+                if(--degree[v] == 1){
+                    queue[tail++] = v;
+                }
+            }
+        }
+    }
+    for(int i = head; i < tail; i++){
+        centres[i - head] = queue[i];
+    }
+    return tail - head;
+}
+
+/**
+ * Roots every tree of a forest in its centre, or in a new node whose children are its two centres, and visits the trees
+ * breadth-first from the roots, appending the nodes to `forests->order` (from position *num_ordered).
+ * The nodes of the graph are numbered from `offset`, the new roots from *num_virtual.
+ */
+static void root_forest(Graph* g, const Components* components, int offset, RootedForests* forests, int* num_ordered,
+                        int* num_virtual, int* degree, int* queue, int* num_roots) {
+    int* order = forests->order;
+    int* parent = forests->parent;
+    int head = *num_ordered;
+    int tail = *num_ordered;
+    for(int k = 0; k < components->num_components; k++){
+        int centres[2] = {0, 0};
+        int num_centres = find_centres(g, components, k, degree, queue, centres);
+        int root = offset + centres[0];
+        if(num_centres == 2){
+            root = (*num_virtual)++;
+        }
+        parent[root] = -1;
+        order[tail++] = root;
+        forests->roots[(*num_roots)++] = root;
+        if(num_centres == 2){
+            for(int i = 0; i < 2; i++){
+                parent[offset + centres[i]] = root;
+                order[tail++] = offset + centres[i];
+            }
+        }
+    }
+    for(; head < tail; head++){
+        int x = order[head];
+        if(x >= 2 * forests->n){
+            continue;
+        }
+        Node* node = &g->nodes[x - offset];
+        for(int i = 0; i < node->num_neighbors; i++){
+            int y = offset + node->neighborhood[i];
+            if(parent[y] == -2){
+                parent[y] = x;
+                order[tail++] = y;
+            }
+        }
+    }
+    *num_ordered = tail;
+}
+
+/**
+ * Computes the AHU labels of every node of both forests:
+ * 1. The height of each node (leaves at 0) is computed from the parents, in reverse breadth-first order, and the children of each node
+ *    are stored contiguously.
+ * 2. The nodes are grouped by height. At each height, the children of every node are sorted by label and the nodes are sorted by
+ *    the sequence of their children's labels: the nodes with equal sequences get the same (new) label. The roots added between two
+ *    centres are sorted apart, so that they never share a label with a node of the graphs.
+ */
+static bool label_forests(RootedForests* forests, int num_ordered) {
+    int size = forests->size;
+    int* level_start = (int*)calloc(size + 2, sizeof(int));
+    int* by_height = (int*)malloc(size * sizeof(int));
+    LevelEntry* entries = (LevelEntry*)malloc(size * sizeof(LevelEntry));
+    if(level_start == NULL || by_height == NULL || entries == NULL){
+        fprintf(stderr, "ERROR: forest labels allocation error");
+        free(level_start);
+        free(by_height);
+        free(entries);
+        return false;
+    }
+
+    // 1. Heights and children
+    int max_height = 0;
+    for(int i = 0; i < num_ordered; i++){
+        forests->height[forests->order[i]] = 0;
+        forests->child_start[forests->order[i]] = 0;
+    }
+    for(int i = num_ordered - 1; i >= 0; i--){
+        int x = forests->order[i];
+        int p = forests->parent[x];
+        if(p >= 0){
+            if(forests->height[p] < forests->height[x] + 1){
+                forests->height[p] = forests->height[x] + 1;
+            }
+            forests->child_start[p]++;
+        }
+        if(forests->height[x] > max_height){
+            max_height = forests->height[x];
+        }
+    }
+    int total = 0;
+    for(int x = 0; x < size; x++){
+        int count = forests->child_start[x];
+        forests->child_start[x] = total;
+        total += count;
+    }
+    forests->child_start[size] = total;
+    for(int i = 0; i < num_ordered; i++){
+        int x = forests->order[i];
+        int p = forests->parent[x];
+        if(p >= 0){
+            // child_start[p] is moved forward while filling and restored below
+            forests->children[forests->child_start[p]++].node = x;
+        }
+    }
+    for(int x = size; x > 0; x--){
+        forests->child_start[x] = forests->child_start[x - 1];
+    }
+    forests->child_start[0] = 0;
+
+    // 2. Labels, level by level
+    for(int i = 0; i < num_ordered; i++){
+        level_start[forests->height[forests->order[i]] + 1]++;
+    }
+    for(int h = 0; h <= max_height; h++){
+        level_start[h + 1] += level_start[h];
+    }
+    for(int i = 0; i < num_ordered; i++){
+        int x = forests->order[i];
+        by_height[level_start[forests->height[x]]++] = x;
+    }
+    for(int h = max_height; h > 0; h--){
+        level_start[h] = level_start[h - 1];
+    }
+    level_start[0] = 0;
+
+    int next_label = 0;
+    for(int h = 0; h <= max_height; h++){
+        int count = 0;
+        for(int i = level_start[h]; i < level_start[h + 1]; i++){
+            int x = by_height[i];
+            LabeledChild* children = &forests->children[forests->child_start[x]];
+            int num_children = forests->child_start[x + 1] - forests->child_start[x];
+            for(int j = 0; j < num_children; j++){
+                children[j].label = forests->label[children[j].node];
+            }
+            sort_children(children, num_children);
+            entries[count].node = x;
+            entries[count].virtual_root = x >= 2 * forests->n;
+            entries[count].num_children = num_children;
+            entries[count].children = children;
+            count++;
+        }
+        qsort(entries, count, sizeof(LevelEntry), compare_level_entries);
+        for(int i = 0; i < count; i++){
+            if(i > 0 && compare_level_entries(&entries[i - 1], &entries[i]) != 0){
+                next_label++;
+            }
+            forests->label[entries[i].node] = next_label;
+        }
+        next_label++;
+    }
+
+    free(level_start);
+    free(by_height);
+    free(entries);
+    return true;
+}
+
+/**
+ * Checks whether the forests have the same multiset of root labels, sorting the roots of each one by label.
+ */
+static bool same_roots(RootedForests* forests, LabeledChild* roots1, LabeledChild* roots2) {
+    if(forests->num_roots1 != forests->num_roots2){
+        return false;
+    }
+    int count = forests->num_roots1;
+    for(int i = 0; i < count; i++){
+        roots1[i].node = forests->roots[i];
+        roots1[i].label = forests->label[roots1[i].node];
+        roots2[i].node = forests->roots[count + i];
+        roots2[i].label = forests->label[roots2[i].node];
+    }
+    qsort(roots1, count, sizeof(LabeledChild), compare_labeled_children);
+    qsort(roots2, count, sizeof(LabeledChild), compare_labeled_children);
+    for(int i = 0; i < count; i++){
+        if(roots1[i].label != roots2[i].label){
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Maps the pairs of nodes pushed on `forests->stack` and then, from them down, the children of two mapped nodes in the order of their
+ * labels: two nodes with the same label have the same sequence of children's labels, and the subtrees with the same label are isomorphic.
+ */
+static void map_forests(RootedForests* forests, Graph* G1, Graph* G2, int top) {
+    int n = forests->n;
+    int* stack = forests->stack;
+    while(top > 0){
+        int b = stack[--top];
+        int a = stack[--top];
+        if(a < n){
+            G1->nodes[a].mapped = b - n;
+            G2->nodes[b - n].mapped = a;
+        }
+        int num_children = forests->child_start[a + 1] - forests->child_start[a];
+        for(int j = 0; j < num_children; j++){
+            stack[top++] = forests->children[forests->child_start[a] + j].node;
+            stack[top++] = forests->children[forests->child_start[b] + j].node;
+        }
+    }
+}
+
+/**
+ * 1. A graph with more than n - 1 edges cannot be a forest: the search runs as usual, without any other check.
+ *    Otherwise the components of both graphs are found and G1 is checked to be a forest; G2 must be one too.
+ * 2. Both forests are rooted (root_forest) and labeled together (label_forests), in arrays of 2n nodes plus the added roots.
+ * 3. The multisets of the root labels are compared and, when they are equal, the mapping is built (map_forests).
+ */
+int forest_isomorphic(Graph* G1, Graph* G2, VF2ppStats* stats) {
+    int n = G1->num_nodes;
+    if(n == 0 || n != G2->num_nodes){
+        return -1;
+    }
+    long degree_sum = 0;
+    for(int u = 0; u < n; u++){
+        degree_sum += G1->nodes[u].num_neighbors;
+    }
+    if(degree_sum > 2L * (n - 1)){
+        return -1;
+    }
+
+    // 1. Components
+    Components c1, c2;
+    if(!find_components(G1, &c1)){
+        return -1;
+    }
+    if(!is_forest(G1, &c1)){
+        free_components(&c1);
+        return -1;
+    }
+    if(!find_components(G2, &c2)){
+        free_components(&c1);
+        return -1;
+    }
+    int result = -1;
+    if(c2.num_components != c1.num_components || !is_forest(G2, &c2)){
+        result = 0;
+    }
+
+    // 2. Rooted forests
+    RootedForests forests;
+    int num_roots = c1.num_components + c2.num_components;
+    int* degree = (int*)malloc(n * sizeof(int));
+    LabeledChild* sorted_roots = (LabeledChild*)malloc((num_roots + 1) * sizeof(LabeledChild));
+    if(!alloc_rooted_forests(&forests, n, 2 * n + num_roots, num_roots) || degree == NULL || sorted_roots == NULL){
+        result = -1;
+    }else if(result == -1){
+        int num_ordered = 0;
+        int num_virtual = 2 * n;
+        int roots = 0;
+        root_forest(G1, &c1, 0, &forests, &num_ordered, &num_virtual, degree, forests.stack, &roots);
+        forests.num_roots1 = roots;
+        root_forest(G2, &c2, n, &forests, &num_ordered, &num_virtual, degree, forests.stack, &roots);
+        forests.num_roots2 = roots - forests.num_roots1;
+        forests.size = num_virtual;
+
+        // 3. Comparison and mapping
+        if(!label_forests(&forests, num_ordered)){
+            result = -1;
+        }else if(!same_roots(&forests, sorted_roots, sorted_roots + forests.num_roots1)){
+            result = 0;
+        }else{
+            for(int i = 0; i < forests.num_roots1; i++){
+                forests.stack[2 * i] = sorted_roots[i].node;
+                forests.stack[2 * i + 1] = sorted_roots[forests.num_roots1 + i].node;
+            }
+            map_forests(&forests, G1, G2, 2 * forests.num_roots1);
+            result = 1;
+        }
+    }
+
+    if(stats != NULL && result >= 0){
+        vf2pp_clear_stats(stats);
+    }
+    free_rooted_forests(&forests);
+    free(degree);
+    free(sorted_roots);
+    free_components(&c1);
+    free_components(&c2);
+    return result;
+}
+
+/**
+ * Removes the nodes of degree 1 from a graph (numbered from `offset` in the forests) until only its 2-core is left.
+ * `removed` is the queue of the nodes whose degree has dropped to 1; every removed node becomes a child of the only neighbor
+ * still in the graph, or a root when none is left (the last node of a tree component). A self loop counts twice in the degree,
+ * as in a multigraph, so that the nodes with a self loop are never removed. Returns the number of removed nodes.
+ */
+static int peel_graph(Graph* g, int offset, RootedForests* forests, bool* core, int* degree, int* removed) {
+    int n = g->num_nodes;
+    int tail = 0;
+    for(int u = 0; u < n; u++){
+        core[u] = true;
+        degree[u] = 0;
+        for(int i = 0; i < g->nodes[u].num_neighbors; i++){
+            degree[u] += (g->nodes[u].neighborhood[i] == u) ? 2 : 1;
+        }
+        if(degree[u] == 1){
+            removed[tail++] = u;
+        }
+    }
+    for(int head = 0; head < tail; head++){
+        int u = removed[head];
+        core[u] = false;
+        forests->parent[offset + u] = -1;
+        for(int i = 0; i < g->nodes[u].num_neighbors; i++){
+            int v = g->nodes[u].neighborhood[i];
+            if(core[v] && v != u){
+                forests->parent[offset + u] = offset + v;
+                if(--degree[v] == 1){
+                    removed[tail++] = v;
+                }
+            }
+        }
+    }
+    for(int u = 0; u < n; u++){
+        if(core[u]){
+            forests->parent[offset + u] = -1;
+        }
+    }
+    return tail;
+}
+
+/**
+ * 1. Peels both graphs (peel_graph), keeping the order of removal.
+ * 2. Orders the nodes with the parents first: the nodes of the 2-cores, then the removed nodes in reverse order of removal
+ *    (a node is removed before its parent), and labels them together (label_forests).
+ */
+bool find_hanging_trees(Graph* G1, Graph* G2, HangingTrees* trees) {
+    int n = G1->num_nodes;
+    memset(trees, 0, sizeof(HangingTrees));
+    trees->forests = (RootedForests*)malloc(sizeof(RootedForests));
+    trees->core1 = (bool*)malloc(n * sizeof(bool));
+    trees->core2 = (bool*)malloc(n * sizeof(bool));
+    int* degree = (int*)malloc(n * sizeof(int));
+    if(trees->forests == NULL || trees->core1 == NULL || trees->core2 == NULL || degree == NULL){
+        fprintf(stderr, "ERROR: hanging trees allocation error");
+        free(trees->forests);
+        trees->forests = NULL;
+        free(degree);
+        free_hanging_trees(trees);
+        return false;
+    }
+    RootedForests* forests = trees->forests;
+    if(!alloc_rooted_forests(forests, n, 2 * n, 0)){
+        free(degree);
+        free_hanging_trees(trees);
+        return false;
+    }
+
+    // 1. Peeling
+    int* removed = forests->stack;
+    int num_removed1 = peel_graph(G1, 0, forests, trees->core1, degree, removed);
+    int num_removed2 = peel_graph(G2, n, forests, trees->core2, degree, removed + num_removed1);
+    for(int i = num_removed1; i < num_removed1 + num_removed2; i++){
+        removed[i] += n;
+    }
+    free(degree);
+
+    // 2. Labels
+    int num_ordered = 0;
+    for(int u = 0; u < n; u++){
+        if(trees->core1[u]){
+            forests->order[num_ordered++] = u;
+        }
+        if(trees->core2[u]){
+            forests->order[num_ordered++] = n + u;
+        }
+    }
+    for(int i = num_removed1 + num_removed2 - 1; i >= 0; i--){
+        forests->order[num_ordered++] = removed[i];
+    }
+    if(!label_forests(forests, num_ordered)){
+        free_hanging_trees(trees);
+        return false;
+    }
+    trees->label1 = forests->label;
+    trees->label2 = forests->label + n;
+    return true;
+}
+
+/**
+ * Pushes every pair of mapped nodes of the 2-cores and maps the trees below them (map_forests).
+ */
+void map_hanging_trees(const HangingTrees* trees, Graph* G1, Graph* G2) {
+    RootedForests* forests = trees->forests;
+    int top = 0;
+    for(int u = 0; u < G1->num_nodes; u++){
+        if(trees->core1[u]){
+            forests->stack[top++] = u;
+            forests->stack[top++] = forests->n + G1->nodes[u].mapped;
+        }
+    }
+    map_forests(forests, G1, G2, top);
+}
+
+/**
+ * Frees the arrays of the trees; the structure itself is not freed.
+ */
+void free_hanging_trees(HangingTrees* trees) {
+    if(trees->forests != NULL){
+        free_rooted_forests(trees->forests);
+        free(trees->forests);
+    }
+    free(trees->core1);
+    free(trees->core2);
+    memset(trees, 0, sizeof(HangingTrees));
+}
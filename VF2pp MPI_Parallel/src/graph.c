@@ -43,6 +43,8 @@
 
 #include "graph.h"
 #include "node_ordering.h"
+#include "symmetry.h"
+#include "bitset.h"
 #include "errno.h"
 #include "limits.h"
 #include "ctype.h"
@@ -58,6 +60,9 @@ Graph* createGraph(int num_nodes){
     Graph* g = (Graph*)malloc(sizeof(Graph));
     g->nodes = (Node*)malloc(num_nodes * sizeof(Node));
     g->num_nodes = num_nodes;
+    g->symmetry = NULL;
+    g->adjacency = NULL;
+    g->signature = NULL;
 
     for(int i = 0; i < num_nodes; i++){
         g->nodes[i].neighborhood = NULL;
@@ -79,6 +84,9 @@ void freeGraph(Graph* g){
     for(int i = 0; i< g->num_nodes; i++){
         free(g->nodes[i].neighborhood);
     }
+    free_symmetry(g->symmetry);
+    free(g->adjacency);
+    free(g->signature);
     free(g->nodes);
     free(g);
 }
@@ -113,6 +121,68 @@ void addEdges(Graph* g, int node, int* list, int neighbours){
     }
 }
 
+/**
+ *
+ *  @details Create a new graph with the same number of nodes
+ *           and copy every neighbour list; the data cached
+ *           with the original graph are not copied.
+ */
+Graph* copyGraph(Graph* g){
+    Graph* copy = createGraph(g->num_nodes);
+    for(int i = 0; i < g->num_nodes; i++){
+        addEdges(copy, i, g->nodes[i].neighborhood, g->nodes[i].num_neighbors);
+    }
+    return copy;
+}
+
+/**
+ *
+ *  @details Create the complement in a single pass over the
+ *           adjacency bitsets of the graph (see bitset.h):
+ *           the bitset of each node in the complement is the NOT
+ *           of its bitset, word by word, without the node itself;
+ *           a self loop is kept as it is, so that the complements
+ *           of two graphs are isomorphic exactly when the graphs
+ *           are. The neighbour list of each node is allocated with
+ *           its exact size (popcount) and filled with a bit-scan,
+ *           and the bitsets are cached with the complement.
+ */
+Graph* complementGraph(Graph* g){
+    int n = g->num_nodes;
+    int words = bitset_words(n);
+    const uint64_t* adjacency = graph_adjacency(g);
+    Graph* c = createGraph(n);
+    uint64_t* complement = (uint64_t*)calloc((size_t)n * words + 1, sizeof(uint64_t));
+    if(adjacency == NULL || complement == NULL){
+        fprintf(stderr, "ERROR: complement graph allocation error");
+        free(complement);
+        freeGraph(c);
+        return NULL;
+    }
+    uint64_t last_word = (n % BITSET_WORD_BITS == 0) ? ~(uint64_t)0 : ((uint64_t)1 << (n % BITSET_WORD_BITS)) - 1;
+    c->adjacency = complement;
+    for(int u = 0; u < n; u++){
+        const uint64_t* row = adjacency + (size_t)u * words;
+        uint64_t* complement_row = complement + (size_t)u * words;
+        for(int k = 0; k < words; k++){
+            complement_row[k] = ~row[k];
+        }
+        complement_row[words - 1] &= last_word;
+        if(!bitset_test(row, u)){
+            bitset_clear(complement_row, u);
+        }
+        int size = bitset_count(complement_row, words);
+        c->nodes[u].neighborhood = (int*)malloc((size + 1) * sizeof(int));
+        if(c->nodes[u].neighborhood == NULL){
+            fprintf(stderr, "ERROR: complement graph allocation error");
+            freeGraph(c);
+            return NULL;
+        }
+        c->nodes[u].num_neighbors = bitset_to_array(complement_row, words, c->nodes[u].neighborhood);
+    }
+    return c;
+}
+
 /**
  *  @details Read a graph from a text file, with a specific format.
  *
@@ -310,6 +380,9 @@ Graph* unflatten_graph(int* flat){
 
     Graph* g = (Graph*)malloc(sizeof(Graph));
     g->num_nodes = flat[pos++];
+    g->symmetry = NULL;
+    g->adjacency = NULL;
+    g->signature = NULL;
     g->nodes = (Node*)malloc(g->num_nodes * sizeof(Node));
 
     for (int i = 0; i < g->num_nodes; i++) {
@@ -30,6 +30,8 @@
 #include <string.h>
 #include "graph.h"
 #include "vf2pp.h"
+#include "canonical.h"
+#include "enumerate.h"
 
 #define MAX_FILENAME_LEN 256
 #define FILENAMES_PATH "./Graphs/"
@@ -40,14 +42,112 @@ int main(int argc, char *argv[]) {
 /* Enable/Disable the verbose mode (printing more information during the run) */
     int VERBOSE = 0;
 
+    /* Compare the canonical certificates first, running VF2++ only when they are equal */
+    bool CERTIFICATE = false;
+
+    /* Optional features of the VF2++ search */
+    VF2ppOptions SEARCH_OPTIONS;
+    vf2pp_default_options(&SEARCH_OPTIONS);
+
+    /* Mappings file whose first mapping is the hint of the learned value ordering, shared by every pattern */
+    const char* HINT_FILE = NULL;
+
     if(argc < 2){
         fprintf(stderr, "ERROR: wrong number of arguments in command line.\n");
-        fprintf(stderr, "Usage: mpirun -n <procs> %s <Graphs_file_name.txt> <OPTIONAL:VERBOSE>\n", argv[0]);
+        fprintf(stderr, "Usage: mpirun -n <procs> %s <Graphs_file_name.txt> <OPTIONAL:VERBOSE> <OPTIONAL:--certificate> <OPTIONAL:--signatures> <OPTIONAL:--nogoods> <OPTIONAL:--forward-checking> <OPTIONAL:--dynamic-order> <OPTIONAL:--all-different=K> <OPTIONAL:--arc-consistency> <OPTIONAL:--value-order=NAME> <OPTIONAL:--hint=file.bin> <OPTIONAL:--endgame=K> <OPTIONAL:--fallback=N> <OPTIONAL:--restarts=N> <OPTIONAL:--seed=S>\n", argv[0]);
         return EXIT_FAILURE;
-    }else if(argc == 3){
+    }
+    for(int i = 2; i < argc; i++){
+        if(strcmp(argv[i], "--certificate") == 0){
+            CERTIFICATE = true;
+            continue;
+        }
+        if(strcmp(argv[i], "--signatures") == 0){
+            SEARCH_OPTIONS.signatures = true;
+            continue;
+        }
+        if(strcmp(argv[i], "--nogoods") == 0){
+            SEARCH_OPTIONS.nogoods = true;
+            continue;
+        }
+        if(strcmp(argv[i], "--forward-checking") == 0){
+            SEARCH_OPTIONS.forward_checking = true;
+            continue;
+        }
+        if(strcmp(argv[i], "--dynamic-order") == 0){
+            SEARCH_OPTIONS.dynamic_order = true;
+            continue;
+        }
+        if(strcmp(argv[i], "--arc-consistency") == 0){
+            SEARCH_OPTIONS.arc_consistency = true;
+            continue;
+        }
+        if(strncmp(argv[i], "--all-different=", 16) == 0){
+            char *endptr;
+            long int val = strtol(argv[i] + 16, &endptr, 10);
+            if (argv[i] + 16 != endptr && *endptr == '\0' && val > 0 && val <= INT_MAX) {
+                SEARCH_OPTIONS.all_different_period = (int)val;
+            }else{
+                fprintf(stderr, "WARNING: --all-different must be a positive integer. Ignoring it.\n");
+            }
+            continue;
+        }
+        if(strncmp(argv[i], "--value-order=", 14) == 0){
+            int strategy = value_order_from_name(argv[i] + 14);
+            if(strategy >= 0){
+                SEARCH_OPTIONS.value_order = strategy;
+            }else{
+                fprintf(stderr, "WARNING: --value-order must be scan, rarest, unmapped, learned or random. Ignoring it.\n");
+            }
+            continue;
+        }
+        if(strncmp(argv[i], "--endgame=", 10) == 0){
+            char *endptr;
+            long int val = strtol(argv[i] + 10, &endptr, 10);
+            if (argv[i] + 10 != endptr && *endptr == '\0' && val > 0 && val <= ENDGAME_MAX_NODES) {
+                SEARCH_OPTIONS.endgame_threshold = (int)val;
+            }else{
+                fprintf(stderr, "WARNING: --endgame must be an integer in [1,%d]. Ignoring it.\n", ENDGAME_MAX_NODES);
+            }
+            continue;
+        }
+        if(strncmp(argv[i], "--fallback=", 11) == 0){
+            char *endptr;
+            long int val = strtol(argv[i] + 11, &endptr, 10);
+            if (argv[i] + 11 != endptr && *endptr == '\0' && val > 0) {
+                SEARCH_OPTIONS.fallback_states = val;
+            }else{
+                fprintf(stderr, "WARNING: --fallback must be a positive integer. Ignoring it.\n");
+            }
+            continue;
+        }
+        if(strncmp(argv[i], "--restarts=", 11) == 0){
+            char *endptr;
+            long int val = strtol(argv[i] + 11, &endptr, 10);
+            if (argv[i] + 11 != endptr && *endptr == '\0' && val > 0) {
+                SEARCH_OPTIONS.restart_base = val;
+            }else{
+                fprintf(stderr, "WARNING: --restarts must be a positive integer. Ignoring it.\n");
+            }
+            continue;
+        }
+        if(strncmp(argv[i], "--seed=", 7) == 0){
+            char *endptr;
+            unsigned long long val = strtoull(argv[i] + 7, &endptr, 10);
+            if (argv[i] + 7 != endptr && *endptr == '\0') {
+                SEARCH_OPTIONS.seed = (uint64_t)val;
+            }else{
+                fprintf(stderr, "WARNING: --seed must be a non-negative integer. Ignoring it.\n");
+            }
+            continue;
+        }
+        if(strncmp(argv[i], "--hint=", 7) == 0){
+            HINT_FILE = argv[i] + 7;
+            continue;
+        }
         char *endptr;
-        long int val = strtol(argv[2], &endptr, 10);
-        if (argv[2] != endptr && *endptr == '\0') {
+        long int val = strtol(argv[i], &endptr, 10);
+        if (argv[i] != endptr && *endptr == '\0') {
             if (val != 0) {
                 fprintf(stderr, "WARNING: this is a parallel program, VERBOSE mode is disabled. Setting VERBOSE to 0.\n");
             }
@@ -123,6 +223,22 @@ int main(int argc, char *argv[]) {
             MPI_Abort(MPI_COMM_WORLD, 1);
         }
 
+        /* Step 5b: broadcast the certificate hash of the main graph, so that workers can discard the patterns with a different one */
+        if(CERTIFICATE){
+            unsigned long long main_hash = 0;
+            Certificate* main_certificate = compute_certificate(main_graph, NULL);
+            if(!main_certificate){
+                fprintf(stderr, "ERROR: certificate of the main graph not computed. Aborting program.\n");
+                MPI_Abort(MPI_COMM_WORLD, 1);
+            }
+            main_hash = main_certificate->hash;
+            free_certificate(main_certificate);
+            if(MPI_Bcast(&main_hash, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD) != MPI_SUCCESS){
+                fprintf(stderr, "ERROR: Rank %d certificate broadcast failed. Aborting program.\n", rank);
+                MPI_Abort(MPI_COMM_WORLD, 1);
+            }
+        }
+
         /* Step 6: collect results */
         bool isIso[file_count-1];
         for(int i = 1; i < file_count; i++){
@@ -189,8 +305,33 @@ int main(int argc, char *argv[]) {
         /* Step 4: unflat the main graph back into the original struct and free the memory assigned to the received flat graph */
         Graph* unflattened_main_graph = unflatten_graph(received_flattened_graph);
 
-        /* Step 5: launch VF2++ coimparison */
-        worker_result = vf2pp_is_isomorphic(unflattened_main_graph, worker_graph);
+        /* Step 4b: read the mapping that the learned value ordering tries first; a pattern similar to the one it was found for gets it */
+        int* hint = NULL;
+        if(HINT_FILE != NULL){
+            hint = malloc(unflattened_main_graph->num_nodes * sizeof(int));
+            if(hint && mapping_file_read(HINT_FILE, unflattened_main_graph->num_nodes, hint)){
+                SEARCH_OPTIONS.value_hint = hint;
+                SEARCH_OPTIONS.value_hint_nodes = unflattened_main_graph->num_nodes;
+            }
+        }
+
+        /* Step 5: launch VF2++ coimparison, skipped when the certificate of the pattern differs from the one of the main graph */
+        bool same_certificate = true;
+        if(CERTIFICATE){
+            unsigned long long main_hash = 0;
+            if(MPI_Bcast(&main_hash, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD) != MPI_SUCCESS){
+                fprintf(stderr, "ERROR: worker %d has failed to receive the certificate of the main graph. Aborting program.\n", rank);
+                MPI_Abort(MPI_COMM_WORLD, 1);
+            }
+            Certificate* worker_certificate = compute_certificate(worker_graph, NULL);
+            if(worker_certificate){
+                same_certificate = worker_certificate->hash == main_hash;
+                free_certificate(worker_certificate);
+            }
+        }
+        if(same_certificate){
+            worker_result = vf2pp_is_isomorphic_with_options(unflattened_main_graph, worker_graph, &SEARCH_OPTIONS, NULL);
+        }
 
         /* Step 6: send result and free the memory from the worker graph */
         if(MPI_Send(&worker_result, 1, MPI_C_BOOL, 0, 0, MPI_COMM_WORLD) != MPI_SUCCESS){
@@ -199,6 +340,7 @@ int main(int argc, char *argv[]) {
         }
         freeGraph(worker_graph);
         freeGraph(unflattened_main_graph);
+        free(hint);
     }
 
 /********************** Finalize MPI logic and close the program ***********************/
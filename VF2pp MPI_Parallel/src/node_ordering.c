@@ -47,7 +47,24 @@
 int compare_context(const void* a, const void* b) {
     Context* context_a = (Context*)a;
     Context* context_b = (Context*)b;
-    return context_b->node->num_neighbors - context_a->node->num_neighbors;
+    if (context_a->node->num_neighbors != context_b->node->num_neighbors) {
+        return context_b->node->num_neighbors - context_a->node->num_neighbors;
+    }
+    return (context_a->tiebreak > context_b->tiebreak) - (context_a->tiebreak < context_b->tiebreak);
+}
+
+/**
+ * Returns the tie-breaking rank of a node for a seed: 0 without a seed, a hash of the seed and the node (the finalizer of
+ * splitmix64) otherwise.
+ */
+static uint64_t _tiebreak(uint64_t seed, int node) {
+    if (seed == 0) {
+        return 0;
+    }
+    uint64_t x = seed ^ ((uint64_t)node * 0x9e3779b97f4a7c15ULL);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
 }
 
 /**
@@ -99,9 +116,12 @@ Level* bfs_next(BFSIterator* iter, Graph* g) {
         max_next_size += g->nodes[node].num_neighbors;
     }
 
-    // Memory allocation for the next level
-    iter->next_level->capacity = max_next_size;
-    iter->next_level->nodes = (int*)malloc(iter->next_level->capacity * sizeof(int));
+    // Memory allocation for the next level, reusing the array of the level visited two steps before when it is large enough
+    if (iter->next_level->capacity < max_next_size || iter->next_level->nodes == NULL) {
+        free(iter->next_level->nodes);
+        iter->next_level->capacity = max_next_size;
+        iter->next_level->nodes = (int*)malloc((max_next_size > 0 ? max_next_size : 1) * sizeof(int));
+    }
 
     // Explore the nodes of the current layer and update the next layer
     for (int i = 0; i < iter->current_level->size; i++) {
@@ -140,10 +160,19 @@ void bfs_free(BFSIterator* iter) {
  * Determines an order for the nodes of a graph based on a combination of their degree and a BFS. Process:
  * 1. Finds the node with the highest degree and adds it to the order.
  * 2. It uses a BFS to explore its neighbors and orders them further by degree.
- * 3. Repeats the process until all nodes are sorted. 
+ * 3. Repeats the process from the highest degree node not yet sorted until all nodes are sorted, so that every connected component is covered. 
  * The goal is to create an order that reflects some sort of “strategic priority” for applications such as optimization or graph matching.
  */
 void matching_order(Graph* G1, int* node_order) {
+    matching_order_seeded(G1, node_order, 0);
+}
+
+/**
+ * Same as matching_order, with the ties between nodes of equal degree broken by their rank for the seed (_tiebreak): the root of
+ * each BFS is the node of maximum degree with the smallest rank, and the nodes of a level are sorted by degree, then by rank.
+ * Without a seed every rank is 0, so the root is the first node of maximum degree and the order is the one of matching_order.
+ */
+void matching_order_seeded(Graph* G1, int* node_order, uint64_t seed) {
     int size = G1->num_nodes;
     bool* ordered = (bool*)malloc(size*sizeof(bool));
     memset(ordered, 0, size * sizeof(bool));
@@ -156,8 +185,9 @@ void matching_order(Graph* G1, int* node_order) {
         int max_node = -1;  // Initializes the node index with the maximum number of neighbors
 
         for (int i = 0; i < G1->num_nodes; i++) {
-          // If the node has more neighbors than the current maximum, update
-          if (G1->nodes[i].num_neighbors > max_neighbors) {
+          // If the node is not sorted yet and has more neighbors than the current maximum, update
+          if (!ordered[i] && (G1->nodes[i].num_neighbors > max_neighbors
+                              || (G1->nodes[i].num_neighbors == max_neighbors && _tiebreak(seed, i) < _tiebreak(seed, max_node)))) {
               max_neighbors = G1->nodes[i].num_neighbors;
               max_node = i;  // Stores the index of the node
           }
@@ -180,6 +210,7 @@ void matching_order(Graph* G1, int* node_order) {
                 int node_index = level->nodes[i];
                 context_array[i].node_index = node_index;
                 context_array[i].node = &G1->nodes[node_index];
+                context_array[i].tiebreak = _tiebreak(seed, node_index);
             }
 
             // Sorting of Contexts by number of neighbors
@@ -195,7 +226,6 @@ void matching_order(Graph* G1, int* node_order) {
         }
 
         bfs_free(iter);
-        num_nodes_ordered++;
 
     }
     free(ordered);
@@ -0,0 +1,223 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file nogood.c
+ * @brief This file contains the functions that record the failed subproblems of a search and find them again.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - nogood.h: Defines the table of nogoods and the fingerprints of the partial mappings.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "nogood.h"
+
+/* Seeds of the two hashes of a fingerprint */
+#define SEED_A 0x9E3779B97F4A7C15ULL
+#define SEED_B 0xD1B54A32D192ED03ULL
+
+/**
+ * Finalizer of splitmix64: every bit of the input affects every bit of the output.
+ */
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * Term of a fingerprint for the image v (u = -1) or for the boundary pair (u, v).
+ */
+static void toggle(Fingerprint* f, int u, int v) {
+    uint64_t x = ((uint64_t)(uint32_t)(u + 1) << 32) | (uint32_t)v;
+    f->a ^= mix64(x ^ SEED_A);
+    f->b ^= mix64(x ^ SEED_B);
+}
+
+/**
+ * Allocates the table and the fingerprints of the depths, then groups the nodes of G1 by the depth of their last neighbor
+ * (counting sort), so that each extension of the fingerprint finds the nodes that leave the boundary.
+ */
+bool init_nogoods(Nogoods* nogoods, Graph* G1, const int* node_order) {
+    int n = G1->num_nodes;
+    memset(nogoods, 0, sizeof(Nogoods));
+    NogoodTable* table = &nogoods->table;
+    table->num_buckets = NOGOOD_TABLE_ENTRIES / NOGOOD_WAYS;
+    table->entries = (Fingerprint*)calloc(NOGOOD_TABLE_ENTRIES, sizeof(Fingerprint));
+    table->referenced = (uint8_t*)calloc(NOGOOD_TABLE_ENTRIES, sizeof(uint8_t));
+    table->hand = (uint8_t*)calloc(table->num_buckets, sizeof(uint8_t));
+    nogoods->prefix = (Fingerprint*)calloc(n + 1, sizeof(Fingerprint));
+    nogoods->last_depth = (int*)malloc(n * sizeof(int));
+    nogoods->closed_start = (int*)calloc(n + 1, sizeof(int));
+    nogoods->closed = (int*)malloc(n * sizeof(int));
+    int* depth_of = (int*)malloc(n * sizeof(int));
+    if (table->entries == NULL || table->referenced == NULL || table->hand == NULL || nogoods->prefix == NULL
+        || nogoods->last_depth == NULL || nogoods->closed_start == NULL || nogoods->closed == NULL || depth_of == NULL) {
+        free(depth_of);
+        free_nogoods(nogoods);
+        return false;
+    }
+    for (int d = 0; d < n; d++) {
+        depth_of[node_order[d]] = d;
+    }
+    for (int u = 0; u < n; u++) {
+        int last = depth_of[u];
+        for (int i = 0; i < G1->nodes[u].num_neighbors; i++) {
+            int d = depth_of[G1->nodes[u].neighborhood[i]];
+            if (d > last) {
+                last = d;
+            }
+        }
+        nogoods->last_depth[u] = last;
+        nogoods->closed_start[last + 1]++;
+    }
+    for (int d = 0; d < n; d++) {
+        nogoods->closed_start[d + 1] += nogoods->closed_start[d];
+    }
+    for (int u = 0; u < n; u++) {
+        nogoods->closed[nogoods->closed_start[nogoods->last_depth[u]]++] = u;
+    }
+    for (int d = n; d > 0; d--) {
+        nogoods->closed_start[d] = nogoods->closed_start[d - 1];
+    }
+    nogoods->closed_start[0] = 0;
+    nogoods->recording = true;
+    free(depth_of);
+    return true;
+}
+
+/**
+ * Frees every array of the nogoods.
+ */
+void free_nogoods(Nogoods* nogoods) {
+    free(nogoods->table.entries);
+    free(nogoods->table.referenced);
+    free(nogoods->table.hand);
+    free(nogoods->prefix);
+    free(nogoods->last_depth);
+    free(nogoods->closed_start);
+    free(nogoods->closed);
+    memset(nogoods, 0, sizeof(Nogoods));
+}
+
+/**
+ * Adds the image v and, when u still has unmapped neighbors after `depth`, the boundary pair (u, v); removes the pairs of the
+ * nodes whose last unmapped neighbor was u.
+ */
+void extend_fingerprint(Nogoods* nogoods, Graph* G1, int depth, int u, int v) {
+    Fingerprint f = nogoods->prefix[depth];
+    toggle(&f, -1, v);
+    if (nogoods->last_depth[u] > depth) {
+        toggle(&f, u, v);
+    }
+    for (int i = nogoods->closed_start[depth]; i < nogoods->closed_start[depth + 1]; i++) {
+        int w = nogoods->closed[i];
+        if (w != u) {
+            toggle(&f, w, G1->nodes[w].mapped);
+        }
+    }
+    nogoods->prefix[depth + 1] = f;
+}
+
+/**
+ * Fingerprint of a depth as stored in the table: the depth is mixed in, and the all-zero value is reserved for the empty entries.
+ */
+static Fingerprint table_key(Nogoods* nogoods, int depth) {
+    Fingerprint key = nogoods->prefix[depth];
+    key.a ^= mix64((uint64_t)depth ^ SEED_B);
+    key.b ^= mix64((uint64_t)depth ^ SEED_A);
+    if (key.a == 0 && key.b == 0) {
+        key.b = 1;
+    }
+    return key;
+}
+
+/**
+ * Scans the bucket of the fingerprint, setting the reference bit of the entry found.
+ */
+bool is_nogood(Nogoods* nogoods, int depth) {
+    NogoodTable* table = &nogoods->table;
+    Fingerprint key = table_key(nogoods, depth);
+    size_t first = (size_t)(key.a & (uint64_t)(table->num_buckets - 1)) * NOGOOD_WAYS;
+    table->lookups++;
+    for (int i = 0; i < NOGOOD_WAYS; i++) {
+        if (table->entries[first + i].a == key.a && table->entries[first + i].b == key.b) {
+            table->referenced[first + i] = 1;
+            table->hits++;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Stores the fingerprint in an empty entry of its bucket, or evicts the entry chosen by the clock hand of the bucket:
+ * the hand clears the reference bits it passes and stops at the first entry whose bit is already clear.
+ */
+void record_nogood(Nogoods* nogoods, int depth) {
+    if (!nogoods->recording) {
+        return;
+    }
+    NogoodTable* table = &nogoods->table;
+    Fingerprint key = table_key(nogoods, depth);
+    size_t bucket = (size_t)(key.a & (uint64_t)(table->num_buckets - 1));
+    size_t first = bucket * NOGOOD_WAYS;
+    for (int i = 0; i < NOGOOD_WAYS; i++) {
+        Fingerprint* entry = &table->entries[first + i];
+        if (entry->a == key.a && entry->b == key.b) {
+            return;
+        }
+        if (entry->a == 0 && entry->b == 0) {
+            *entry = key;
+            table->referenced[first + i] = 0;
+            return;
+        }
+    }
+    int hand = table->hand[bucket];
+    while (table->referenced[first + hand]) {
+        table->referenced[first + hand] = 0;
+        hand = (hand + 1) % NOGOOD_WAYS;
+    }
+    table->entries[first + hand] = key;
+    table->hand[bucket] = (uint8_t)((hand + 1) % NOGOOD_WAYS);
+}
+
+/**
+ * Swaps the two tables, whose sizes are always NOGOOD_TABLE_ENTRIES.
+ */
+void transfer_nogoods(Nogoods* to, Nogoods* from) {
+    NogoodTable table = to->table;
+    to->table = from->table;
+    from->table = table;
+}
@@ -39,13 +39,13 @@
 #include "stack.h"
 
 /**
- * Initializes an empty stack with a default minimum capacity (4 elements).
+ * Initializes an empty stack with the given capacity (at least 4 elements).
  * Allocates memory for the dynamic array of stack elements and sets the top index to -1, indicating that the stack is initially empty.
  * If the memory allocation fails, an error with perror is shown and the program terminates.
  * The initial capacity can be dynamically increased later.
  */
-void init_stack(Stack* stack) {
-    stack->capacity = 4;
+void init_stack(Stack* stack, int capacity) {
+    stack->capacity = (capacity > 4) ? capacity : 4;
     stack->elements = malloc(stack->capacity * sizeof(NodeCandidates));
     if (stack->elements == NULL) {
         fprintf(stderr, "Stack allocation error");
@@ -70,38 +70,18 @@ void resize_stack(Stack* stack, int new_capacity) {
     stack->capacity = new_capacity;
 }
 
-/**
- * It reduces the capacity of the stack if the number of elements (top) is less than a quarter of the current capacity and if the capacity is greater than the minimum capacity (4 elements).
- * The function uses resize_stack to reduce the memory used. 
- * It maintains stack efficiency by limiting memory wastage when the number of elements is much less than the allocated capacity.
- */
-void shrink_stack(Stack* stack) {
-    if (stack->top < stack->capacity / 4 && stack->capacity > 4) {
-        resize_stack(stack, stack->capacity / 2);
-    }
-}
-
 /**
  * Adds a new element of type NodeCandidates to the top of the stack.
  *  If the stack is full, it automatically doubles its capacity using resize_stack.
- *  Allocates memory for the array flags of each NodeCandidates and initializes it to false for each candidate.
+ *  Sets the cursor of the element to its first candidate, so no candidate has been tried yet.
  *  Increments the top index to add the new element.
- *  If the memory allocation for flags fails, the program terminates.
  */
 void push(Stack* stack, NodeCandidates node) {
     if (stack->top == stack->capacity - 1) {
         resize_stack(stack, stack->capacity * 2);
     }
 
-    node.flags = malloc(node.num_candidates * sizeof(bool));
-    if (node.flags == NULL) {
-        fprintf(stderr, "Allocation error for flags");
-        exit(EXIT_FAILURE);
-    }
-
-    for (int i = 0; i < node.num_candidates; i++) {
-        node.flags[i] = false;
-    }
+    node.cursor = 0;
 
     stack->top++;
     stack->elements[stack->top] = node; 
@@ -109,9 +89,8 @@ void push(Stack* stack, NodeCandidates node) {
 
 /**
  * Removes and returns the element at the top of the stack. 
- * Reduces the capacity of the stack using shrink_stack if there are few elements over capacity. 
- * Frees the memory associated with the candidates and flags arrays of the removed node.
- * If the stack is empty (top == -1), shows an error and terminates the program. Returns the removed element, with the freed arrays (arrays are no longer valid).
+ * The capacity is kept, so no memory is released.
+ * If the stack is empty (top == -1), shows an error and terminates the program. Returns the removed element.
  */
 NodeCandidates pop(Stack* stack) {
     if (stack->top == -1) {
@@ -121,28 +100,16 @@ NodeCandidates pop(Stack* stack) {
 
     NodeCandidates node = stack->elements[stack->top];
 
-    free(node.candidates);
-    free(node.flags);
-
     stack->top--;
 
-    shrink_stack(stack);
-
     return node; 
 }
 
 /**
- * Frees up all memory associated with the stack, including: 
- *   the dynamic candidates and flags arrays of each NodeCandidates in the stack. 
- *   the dynamic elements array that contains the NodeCandidates objects.
- * Iterate on all elements in the stack to free the internal arrays.
+ * Frees up the dynamic elements array that contains the NodeCandidates objects.
  * After liberation, the stack can no longer be used without a new initialization.
  */
 void free_stack(Stack* stack) {
-    for (int i = 0; i <= stack->top; i++) {
-        free(stack->elements[i].candidates); 
-        free(stack->elements[i].flags);      
-    }
     free(stack->elements);
 }
 
@@ -0,0 +1,429 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "bitset.h"
+#include "find_candidates.h"
+#include "signature.h"
+#include "twins.h"
+
+/**
+ * Node with the hash of its neighborhood, sorted to bring the candidate twins together.
+ */
+typedef struct {
+    uint64_t hash;
+    int node;
+} HashedNeighborhood;
+
+static int compare_hashed(const void* a, const void* b) {
+    const HashedNeighborhood* x = (const HashedNeighborhood*)a;
+    const HashedNeighborhood* y = (const HashedNeighborhood*)b;
+    if(x->hash != y->hash) return (x->hash < y->hash) ? -1 : 1;
+    return (x->node > y->node) - (x->node < y->node);
+}
+
+static int compare_int(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Mixes the bits of a value (murmur3 finalizer): the hash of a neighborhood in a sparse graph is the sum of the mixed neighbors.
+ */
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    return x ^ (x >> 33);
+}
+
+/**
+ * Data shared by the two passes of find_twin_classes: the adjacency bitsets for dense graphs, the marks of a neighborhood otherwise.
+ */
+typedef struct {
+    Graph* g;
+    const uint64_t* adjacency;
+    int words;
+    int* mark;
+    int stamp;
+} TwinSearch;
+
+static bool has_self_loop(TwinSearch* search, int u) {
+    if(search->adjacency != NULL){
+        return bitset_test(search->adjacency + (size_t)u * search->words, u);
+    }
+    Node* node = &search->g->nodes[u];
+    for(int i = 0; i < node->num_neighbors; i++){
+        if(node->neighborhood[i] == u){
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Hash of the open (or closed) neighborhood of u: FNV-1a on the words of its bitset, or the sum of its mixed neighbors.
+ */
+static uint64_t neighborhood_hash(TwinSearch* search, int u, bool closed) {
+    if(search->adjacency != NULL){
+        const uint64_t* row = search->adjacency + (size_t)u * search->words;
+        uint64_t h = 1469598103934665603ULL;
+        for(int k = 0; k < search->words; k++){
+            uint64_t word = row[k];
+            if(closed && k == u / BITSET_WORD_BITS){
+                word |= (uint64_t)1 << (u % BITSET_WORD_BITS);
+            }
+            h = (h ^ word) * 1099511628211ULL;
+        }
+        return h;
+    }
+    Node* node = &search->g->nodes[u];
+    uint64_t h = closed ? mix((uint64_t)u) : 0;
+    for(int i = 0; i < node->num_neighbors; i++){
+        h += mix((uint64_t)node->neighborhood[i]);
+    }
+    return mix(h ^ (uint64_t)node->num_neighbors);
+}
+
+/**
+ * Marks the neighborhood of u, so that the neighborhoods of the following nodes can be compared with it (same_neighborhood).
+ */
+static void mark_neighborhood(TwinSearch* search, int u, bool closed) {
+    if(search->adjacency != NULL){
+        return;
+    }
+    search->stamp++;
+    Node* node = &search->g->nodes[u];
+    for(int i = 0; i < node->num_neighbors; i++){
+        search->mark[node->neighborhood[i]] = search->stamp;
+    }
+    if(closed){
+        search->mark[u] = search->stamp;
+    }
+}
+
+/**
+ * Checks whether w has the same neighborhood as u, the last node marked: comparing the bitsets word by word (adding u and w
+ * to their closed neighborhoods), or checking that every neighbor of w is marked, since both have the same degree.
+ */
+static bool same_neighborhood(TwinSearch* search, int u, int w, bool closed) {
+    Graph* g = search->g;
+    if(g->nodes[u].num_neighbors != g->nodes[w].num_neighbors){
+        return false;
+    }
+    if(search->adjacency != NULL){
+        const uint64_t* row_u = search->adjacency + (size_t)u * search->words;
+        const uint64_t* row_w = search->adjacency + (size_t)w * search->words;
+        for(int k = 0; k < search->words; k++){
+            uint64_t word_u = row_u[k];
+            uint64_t word_w = row_w[k];
+            if(closed && k == u / BITSET_WORD_BITS) word_u |= (uint64_t)1 << (u % BITSET_WORD_BITS);
+            if(closed && k == w / BITSET_WORD_BITS) word_w |= (uint64_t)1 << (w % BITSET_WORD_BITS);
+            if(word_u != word_w){
+                return false;
+            }
+        }
+        return true;
+    }
+    Node* node = &g->nodes[w];
+    for(int i = 0; i < node->num_neighbors; i++){
+        if(search->mark[node->neighborhood[i]] != search->stamp){
+            return false;
+        }
+    }
+    return !closed || search->mark[w] == search->stamp;
+}
+
+/**
+ * Groups into classes of at least two nodes the nodes without a class and with the same open (or closed) neighborhood:
+ * the nodes are sorted by hash and, in each run of equal hashes, every node without a class is compared with the following ones.
+ * Returns the number of classes after the new ones.
+ */
+static int group_twins(TwinSearch* search, TwinClasses* twins, HashedNeighborhood* hashed, bool closed) {
+    int n = search->g->num_nodes;
+    int count = 0;
+    for(int u = 0; u < n; u++){
+        if(twins->class_of[u] == -1 && !has_self_loop(search, u)){
+            hashed[count].hash = neighborhood_hash(search, u, closed);
+            hashed[count].node = u;
+            count++;
+        }
+    }
+    qsort(hashed, count, sizeof(HashedNeighborhood), compare_hashed);
+
+    int num_classes = twins->num_classes;
+    for(int start = 0; start < count; ){
+        int end = start + 1;
+        while(end < count && hashed[end].hash == hashed[start].hash){
+            end++;
+        }
+        for(int i = start; i < end - 1; i++){
+            int u = hashed[i].node;
+            if(twins->class_of[u] != -1){
+                continue;
+            }
+            mark_neighborhood(search, u, closed);
+            for(int j = i + 1; j < end; j++){
+                int w = hashed[j].node;
+                if(twins->class_of[w] == -1 && same_neighborhood(search, u, w, closed)){
+                    if(twins->class_of[u] == -1){
+                        twins->kind[num_classes] = closed ? TWIN_CLOSED : TWIN_OPEN;
+                        twins->class_of[u] = num_classes++;
+                    }
+                    twins->class_of[w] = twins->class_of[u];
+                }
+            }
+        }
+        start = end;
+    }
+    return num_classes;
+}
+
+/**
+ * 1. Groups the open twins first and then, among the nodes left alone, the closed twins (group_twins): the nodes with a self loop
+ *    are always left alone. Both relations are equivalences, so the classes do not depend on the numbering of the nodes.
+ * 2. Gives a class of its own to every node left, and lists the nodes of each class (counting sort).
+ */
+bool find_twin_classes(Graph* g, TwinClasses* twins) {
+    int n = g->num_nodes;
+    memset(twins, 0, sizeof(TwinClasses));
+    TwinSearch search;
+    search.g = g;
+    search.words = bitset_words(n);
+    search.stamp = 0;
+    long degree_sum = 0;
+    for(int u = 0; u < n; u++){
+        degree_sum += g->nodes[u].num_neighbors;
+    }
+    bool dense = degree_sum >= (long)n * search.words;
+    search.adjacency = (dense && n <= CANDIDATE_BITSET_MAX_NODES) ? graph_adjacency(g) : NULL;
+    search.mark = (int*)calloc(n + 1, sizeof(int));
+    HashedNeighborhood* hashed = (HashedNeighborhood*)malloc((n + 1) * sizeof(HashedNeighborhood));
+    twins->class_of = (int*)malloc((n + 1) * sizeof(int));
+    twins->start = (int*)calloc(n + 2, sizeof(int));
+    twins->members = (int*)malloc((n + 1) * sizeof(int));
+    twins->kind = (int*)malloc((n + 1) * sizeof(int));
+    if(search.mark == NULL || hashed == NULL || twins->class_of == NULL || twins->start == NULL || twins->members == NULL || twins->kind == NULL){
+        fprintf(stderr, "ERROR: twin classes allocation error");
+        free(search.mark);
+        free(hashed);
+        free_twin_classes(twins);
+        return false;
+    }
+
+    // 1. Open and closed twins
+    for(int u = 0; u < n; u++){
+        twins->class_of[u] = -1;
+    }
+    twins->num_classes = group_twins(&search, twins, hashed, false);
+    twins->num_classes = group_twins(&search, twins, hashed, true);
+
+    // 2. Single nodes and members
+    for(int u = 0; u < n; u++){
+        if(twins->class_of[u] == -1){
+            twins->kind[twins->num_classes] = TWIN_SINGLE;
+            twins->class_of[u] = twins->num_classes++;
+        }
+        twins->start[twins->class_of[u] + 1]++;
+    }
+    for(int c = 0; c < twins->num_classes; c++){
+        twins->start[c + 1] += twins->start[c];
+    }
+    for(int u = 0; u < n; u++){
+        twins->members[twins->start[twins->class_of[u]]++] = u;
+    }
+    for(int c = twins->num_classes; c > 0; c--){
+        twins->start[c] = twins->start[c - 1];
+    }
+    twins->start[0] = 0;
+
+    free(search.mark);
+    free(hashed);
+    return true;
+}
+
+/**
+ * Frees the arrays of the classes; the structure itself is not freed.
+ */
+void free_twin_classes(TwinClasses* twins) {
+    free(twins->class_of);
+    free(twins->start);
+    free(twins->members);
+    free(twins->kind);
+    memset(twins, 0, sizeof(TwinClasses));
+}
+
+/**
+ * Creates the quotient graph: the neighbors of a class are the classes of the neighbors of its first node (all the nodes of a class
+ * have the same neighbors outside it), each listed once thanks to `mark`. A single node keeps its self loop.
+ */
+static Graph* quotient_graph(Graph* g, const TwinClasses* twins, int* mark) {
+    int k = twins->num_classes;
+    Graph* q = createGraph(k);
+    if(q == NULL || q->nodes == NULL){
+        fprintf(stderr, "ERROR: quotient graph allocation error");
+        free(q);
+        return NULL;
+    }
+    for(int c = 0; c < k; c++){
+        mark[c] = -1;
+    }
+    for(int c = 0; c < k; c++){
+        Node* node = &g->nodes[twins->members[twins->start[c]]];
+        int* list = (int*)malloc((node->num_neighbors + 1) * sizeof(int));
+        if(list == NULL){
+            fprintf(stderr, "ERROR: quotient graph allocation error");
+            freeGraph(q);
+            return NULL;
+        }
+        int count = 0;
+        for(int i = 0; i < node->num_neighbors; i++){
+            int d = twins->class_of[node->neighborhood[i]];
+            if((d != c || twins->kind[c] == TWIN_SINGLE) && mark[d] != c){
+                mark[d] = c;
+                list[count++] = d;
+            }
+        }
+        q->nodes[c].neighborhood = list;
+        q->nodes[c].num_neighbors = count;
+    }
+    return q;
+}
+
+/**
+ * 1. Finds the twin classes of G1: without twins, or with self loops (which the feasibility rules of the search do not count),
+ *    the whole graphs are searched.
+ * 2. Finds the twin classes of G2: the graphs are not isomorphic unless they have the same multiset of class labels (size and kind).
+ * 3. Builds the quotient graphs, with the labels in their node keys (set_label_keys), and runs VF2++ on them.
+ * 4. Expands the mapping: the i-th node of a class of G1 is mapped to the i-th node of the image class.
+ */
+int twins_isomorphic(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats) {
+    int n = G1->num_nodes;
+    if(n == 0 || n != G2->num_nodes){
+        return -1;
+    }
+
+    // 1. Twins of G1
+    TwinClasses t1, t2;
+    if(!find_twin_classes(G1, &t1)){
+        return -1;
+    }
+    bool loops = false;
+    for(int u = 0; u < n && !loops; u++){
+        for(int i = 0; i < G1->nodes[u].num_neighbors; i++){
+            loops = loops || G1->nodes[u].neighborhood[i] == u;
+        }
+    }
+    if(t1.num_classes == n || loops){
+        free_twin_classes(&t1);
+        return -1;
+    }
+    if(!find_twin_classes(G2, &t2)){
+        free_twin_classes(&t1);
+        return -1;
+    }
+
+    // 2. Labels
+    int k = t1.num_classes;
+    int result = -1;
+    int* labels1 = (int*)malloc((n + 1) * sizeof(int));
+    int* labels2 = (int*)malloc((n + 1) * sizeof(int));
+    int* sorted = (int*)malloc(2 * (n + 1) * sizeof(int));
+    if(labels1 == NULL || labels2 == NULL || sorted == NULL){
+        fprintf(stderr, "ERROR: twin quotient allocation error");
+    }else if(t2.num_classes != k){
+        result = 0;
+    }else{
+        for(int c = 0; c < k; c++){
+            labels1[c] = 3 * (t1.start[c + 1] - t1.start[c]) + t1.kind[c];
+            labels2[c] = 3 * (t2.start[c + 1] - t2.start[c]) + t2.kind[c];
+            sorted[c] = labels1[c];
+            sorted[k + c] = labels2[c];
+        }
+        qsort(sorted, k, sizeof(int), compare_int);
+        qsort(sorted + k, k, sizeof(int), compare_int);
+        if(memcmp(sorted, sorted + k, k * sizeof(int)) != 0){
+            result = 0;
+        }
+    }
+
+    // 3. Search on the quotients
+    VF2ppStats quotient_stats;
+    vf2pp_clear_stats(&quotient_stats);
+    if(result == -1 && sorted != NULL){
+        VF2ppOptions quotient_options;
+        if(options != NULL){
+            quotient_options = *options;
+        }else{
+            vf2pp_default_options(&quotient_options);
+        }
+        quotient_options.symmetry_breaking = false;
+        Graph* Q1 = quotient_graph(G1, &t1, sorted);
+        Graph* Q2 = quotient_graph(G2, &t2, sorted);
+        if(Q1 != NULL && Q2 != NULL && set_label_keys(Q1, labels1, quotient_options.signatures)
+           && set_label_keys(Q2, labels2, quotient_options.signatures)){
+            result = 0;
+            VF2ppState* state = vf2pp_init(Q1, Q2, &quotient_options);
+            if(state != NULL){
+                if(vf2pp_next(state, NULL)){
+                    result = 1;
+                }
+                quotient_stats = state->stats;
+                vf2pp_free(state);
+            }
+        }
+
+        // 4. Expansion
+        if(result == 1){
+            for(int c = 0; c < k; c++){
+                int d = Q1->nodes[c].mapped;
+                for(int i = 0; i < t1.start[c + 1] - t1.start[c]; i++){
+                    int u = t1.members[t1.start[c] + i];
+                    int v = t2.members[t2.start[d] + i];
+                    G1->nodes[u].mapped = v;
+                    G2->nodes[v].mapped = u;
+                }
+            }
+        }
+        if(Q1 != NULL) freeGraph(Q1);
+        if(Q2 != NULL) freeGraph(Q2);
+    }
+
+    if(stats != NULL && result >= 0){
+        *stats = quotient_stats;
+    }
+    free(labels1);
+    free(labels2);
+    free(sorted);
+    free_twin_classes(&t1);
+    free_twin_classes(&t2);
+    return result;
+}
@@ -0,0 +1,206 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file bitset.h
+ * @brief This file defines the bitsets used to represent sets of nodes and the kernels that operate on them.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ */
+
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+
+/* Number of bits stored in each word of a bitset */
+#define BITSET_WORD_BITS 64
+
+/**
+ * @brief This function returns the number of words needed to store a bitset.
+ *
+ * @param num_bits Number of bits of the bitset.
+ * @return The number of 64-bit words.
+ */
+static inline int bitset_words(int num_bits) {
+    return (num_bits + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+}
+
+/**
+ * @brief This function sets a bit.
+ *
+ * @param bits Pointer to the bitset.
+ * @param i Index of the bit.
+ */
+static inline void bitset_set(uint64_t* bits, int i) {
+    bits[i / BITSET_WORD_BITS] |= (uint64_t)1 << (i % BITSET_WORD_BITS);
+}
+
+/**
+ * @brief This function clears a bit.
+ *
+ * @param bits Pointer to the bitset.
+ * @param i Index of the bit.
+ */
+static inline void bitset_clear(uint64_t* bits, int i) {
+    bits[i / BITSET_WORD_BITS] &= ~((uint64_t)1 << (i % BITSET_WORD_BITS));
+}
+
+/**
+ * @brief This function checks a bit.
+ *
+ * @param bits Pointer to the bitset.
+ * @param i Index of the bit.
+ * @return True if the bit is set.
+ */
+static inline bool bitset_test(const uint64_t* bits, int i) {
+    return (bits[i / BITSET_WORD_BITS] >> (i % BITSET_WORD_BITS)) & 1;
+}
+
+/**
+ * @brief This function returns the index of the lowest bit set in a word.
+ *
+ * @param word The word, not zero.
+ * @return The index of the lowest bit set.
+ */
+static inline int bitset_lowest_bit(uint64_t word) {
+#ifdef __GNUC__
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (((word >> bit) & 1) == 0) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief This function returns the index of the highest bit set in a word.
+ *
+ * @param word The word, not zero.
+ * @return The index of the highest bit set.
+ */
+static inline int bitset_highest_bit(uint64_t word) {
+#ifdef __GNUC__
+    return BITSET_WORD_BITS - 1 - __builtin_clzll(word);
+#else
+    int bit = BITSET_WORD_BITS - 1;
+    while (((word >> bit) & 1) == 0) {
+        bit--;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief This function selects the kernels for the current CPU.
+ *
+ * The first kernel called selects them anyway; this function must be called before the kernels are used by several threads at once.
+ */
+void bitset_init_kernels(void);
+
+/**
+ * @brief This function allocates a bitset with every bit cleared.
+ *
+ * @param num_bits Number of bits of the bitset.
+ * @return Pointer to the bitset, or NULL if memory cannot be allocated.
+ */
+uint64_t* bitset_alloc(int num_bits);
+
+/**
+ * @brief This function computes `dst &= src`.
+ *
+ * @param dst Pointer to the bitset updated.
+ * @param src Pointer to the other bitset.
+ * @param words Number of words of the bitsets.
+ * @return True if at least one bit of the result is set.
+ */
+bool bitset_and(uint64_t* dst, const uint64_t* src, int words);
+
+/**
+ * @brief This function computes `dst = a & b`.
+ *
+ * @param dst Pointer to the bitset written.
+ * @param a Pointer to the first bitset.
+ * @param b Pointer to the second bitset.
+ * @param words Number of words of the bitsets.
+ * @return True if at least one bit of the result is set.
+ */
+bool bitset_and3(uint64_t* dst, const uint64_t* a, const uint64_t* b, int words);
+
+/**
+ * @brief This function counts the bits set.
+ *
+ * @param bits Pointer to the bitset.
+ * @param words Number of words of the bitset.
+ * @return The number of bits set.
+ */
+int bitset_count(const uint64_t* bits, int words);
+
+/**
+ * @brief This function counts the bits set in `a & b`, without writing the intersection.
+ *
+ * @param a Pointer to the first bitset.
+ * @param b Pointer to the second bitset.
+ * @param words Number of words of the bitsets.
+ * @return The number of bits set in both bitsets.
+ */
+int bitset_and_count(const uint64_t* a, const uint64_t* b, int words);
+
+/**
+ * @brief This function writes the index of every bit set, in ascending order.
+ *
+ * @param bits Pointer to the bitset.
+ * @param words Number of words of the bitset.
+ * @param out Array filled with the indexes, large enough for every bit set.
+ * @return The number of indexes written.
+ */
+int bitset_to_array(const uint64_t* bits, int words, int* out);
+
+/**
+ * @brief This function returns the name of the kernels selected for the current CPU ("avx512", "avx2" or "portable").
+ *
+ * @return The name of the kernels.
+ */
+const char* bitset_kernel_name(void);
+
+/**
+ * @brief This function returns the adjacency matrix of a graph as one bitset per node, building and caching it the first time.
+ *
+ * The bitset of node `u` starts at `u * bitset_words(g->num_nodes)`.
+ *
+ * @param g Pointer to the graph.
+ * @return Pointer to the adjacency bitsets owned by the graph, or NULL if memory cannot be allocated.
+ */
+uint64_t* graph_adjacency(Graph* g);
+
+#endif // BITSET_H
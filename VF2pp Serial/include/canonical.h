@@ -0,0 +1,115 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file canonical.h
+ * @brief This file defines the canonical labeling of a graph and the certificate that identifies its isomorphism class.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ */
+
+#ifndef CANONICAL_H
+#define CANONICAL_H
+
+#include <stdbool.h>
+#include "graph.h"
+
+/**
+ * @struct Certificate
+ * @brief This structure contains the canonical form of a graph: two graphs are isomorphic if and only if their certificates are equal.
+ *
+ * The canonical labeling is found by color refinement and individualization-refinement: the code lists, for each canonical label in
+ * ascending order, the degree of its node followed by the sorted canonical labels of its neighbours, and then the color of each
+ * canonical label when the graph is colored.
+ *
+ * @var Certificate::num_nodes
+ * Number of nodes of the graph.
+ * @var Certificate::num_edges
+ * Number of edges of the graph (half the sum of the degrees).
+ * @var Certificate::hash
+ * Hash of the code, used to compare and bucket the certificates quickly.
+ * @var Certificate::code
+ * Canonical code of the graph, `code_size` elements.
+ * @var Certificate::code_size
+ * Number of elements of `code`.
+ * @var Certificate::labeling
+ * Canonical label of each node of the graph.
+ * @var Certificate::num_leaves
+ * Number of leaves of the individualization-refinement tree that have been visited.
+ * @var Certificate::num_generators
+ * Number of automorphisms found during the search and used to prune it.
+ */
+typedef struct Certificate {
+    int num_nodes;
+    int num_edges;
+    unsigned long long hash;
+    int* code;
+    int code_size;
+    int* labeling;
+    long num_leaves;
+    int num_generators;
+} Certificate;
+
+/**
+ * @brief This function computes the canonical labeling of a graph and its certificate.
+ *
+ * @param g Pointer to the graph.
+ * @param colors Array with the color of each node, NULL if the graph is not colored. Colors are compared by value, so two graphs
+ *               are isomorphic only by mappings that preserve them.
+ * @return Pointer to the certificate, or NULL if memory cannot be allocated.
+ */
+Certificate* compute_certificate(Graph* g, const int* colors);
+
+/**
+ * @brief This function compares two certificates.
+ *
+ * @param c1 Pointer to the first certificate.
+ * @param c2 Pointer to the second certificate.
+ * @return True if the certificates are equal, that is the graphs are isomorphic.
+ */
+bool certificates_equal(const Certificate* c1, const Certificate* c2);
+
+/**
+ * @brief This function builds the isomorphism given by two equal certificates: each node is mapped to the node with the same canonical label.
+ *
+ * @param c1 Pointer to the certificate of G1.
+ * @param c2 Pointer to the certificate of G2.
+ * @param mapping Array of `c1->num_nodes` elements filled with the image in G2 of each node of G1.
+ * @return True if the certificates are equal and the mapping has been built.
+ */
+bool certificate_mapping(const Certificate* c1, const Certificate* c2, int* mapping);
+
+/**
+ * @brief Frees up the memory allocated for the certificate. NULL is accepted.
+ *
+ * @param cert Pointer to the certificate.
+ */
+void free_certificate(Certificate* cert);
+
+#endif // CANONICAL_H
@@ -0,0 +1,112 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file components.h
+ * @brief This file defines the decomposition of a graph into connected components and the isomorphism test that matches the components independently.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - vf2pp.h: Definition of the VF2++ search run on each pair of components.
+ */
+
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+#include "vf2pp.h"
+
+/**
+ * @struct Components
+ * @brief This structure contains the connected components of a graph.
+ *
+ * @var Components::num_components
+ * Number of connected components.
+ * @var Components::component
+ * Component of each node.
+ * @var Components::local
+ * Index of each node inside its component.
+ * @var Components::start
+ * Position in `nodes` of the first node of each component; it has `num_components + 1` elements, the last one is the number of nodes.
+ * @var Components::nodes
+ * Nodes grouped by component, each component in breadth-first order.
+ */
+typedef struct {
+    int num_components;
+    int* component;
+    int* local;
+    int* start;
+    int* nodes;
+} Components;
+
+/**
+ * @brief This function finds the connected components of a graph with a breadth-first search.
+ *
+ * @param g Pointer to the graph.
+ * @param components Pointer to the components to be filled.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool find_components(Graph* g, Components* components);
+
+/**
+ * @brief Frees up the memory allocated for the components.
+ *
+ * @param components Pointer to the components to be freed.
+ */
+void free_components(Components* components);
+
+/**
+ * @brief This function creates the subgraph induced by a connected component, with its nodes renumbered by `Components::local`.
+ *
+ * @param g Pointer to the graph.
+ * @param components Pointer to the components of `g`.
+ * @param k Index of the component.
+ * @return The created graph, or NULL if memory cannot be allocated.
+ */
+Graph* component_graph(Graph* g, const Components* components, int k);
+
+/**
+ * @brief This function checks whether two graphs are isomorphic by matching their connected components independently.
+ *
+ * The components of both graphs are compared first by size, number of edges and degrees: when these multisets differ the graphs
+ * cannot be isomorphic. Then every component of G1 is matched by VF2++ to a component of G2 with the same invariants; the
+ * results are memoized for each pair of components, and the components are processed in parallel when the program is built with OpenMP.
+ * When the graphs are isomorphic, the `mapped` field of each node of G1 (G2) contains its image in G2 (G1).
+ *
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param options Pointer to the options of the search of each pair of components, NULL for the default ones.
+ * @param stats Pointer filled with the statistics of all the searches, NULL if they are not needed.
+ * @return 1 if the graphs are isomorphic, 0 if they are not, -1 if G1 is connected (or the graphs have different sizes, or memory
+ *         cannot be allocated) and a single search must be run instead.
+ */
+int vf2pp_components_isomorphic(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats);
+
+#endif // COMPONENTS_H
@@ -0,0 +1,196 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file domains.h
+ * @brief This file defines the domains of the nodes of G1, narrowed after each assignment of the search (forward checking).
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - bitset.h: Definition of the bitsets that store the domains.
+ * - find_candidates.h: Definition of the classes of the nodes.
+ * - dynamic_order.h: Definition of the keys updated with the domains.
+ */
+
+#ifndef DOMAINS_H
+#define DOMAINS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "graph.h"
+#include "bitset.h"
+#include "find_candidates.h"
+#include "dynamic_order.h"
+
+/**
+ * @struct DomainChange
+ * @brief This structure records a word of a domain before it was narrowed.
+ *
+ * @var DomainChange::index
+ * Index of the word in `Domains::bits`.
+ * @var DomainChange::bits
+ * Value of the word before the change.
+ */
+typedef struct {
+    size_t index;
+    uint64_t bits;
+} DomainChange;
+
+/**
+ * @struct DomainLevel
+ * @brief This structure records how the domains changed when the pair of a depth was mapped, so that the change can be undone.
+ *
+ * @var DomainLevel::trail_start
+ * Size of `Domains::trail` before the pair was mapped.
+ * @var DomainLevel::overflow
+ * True if the trail was full before every change of the depth was recorded: the domains changed are then recomputed.
+ */
+typedef struct {
+    int trail_start;
+    bool overflow;
+} DomainLevel;
+
+/**
+ * @struct Domains
+ * @brief This structure contains the domain of each node of G1 and the trail of their changes.
+ *
+ * The domain of an unmapped node u is the set of nodes of G2 in its initial domain that are adjacent to the images of all the
+ * mapped neighbors of u; the initial domain is its class, or a subset of it when the domains are filtered before the search
+ * (see arc_consistency.h). When u is in T1 its candidates are the domain AND T2, otherwise the domain is its initial domain and
+ * its candidates are the domain AND T2_tilde. Mapping a pair ANDs the domains of the unmapped neighbors of its node with the neighbors of its image,
+ * and the words changed are pushed on a trail, so that unmapping it only writes them back. When a domain is left without
+ * candidates, no mapping can extend the current one: the search rejects the pair at once, instead of finding out when it reaches
+ * that node.
+ * The trail holds as many changes as the words of all the domains; the changes of a depth that does not fit are undone by
+ * recomputing the domains of the neighbors from the images of their mapped neighbors.
+ *
+ * @var Domains::num_nodes
+ * Number of nodes of the graphs.
+ * @var Domains::words
+ * Number of words of each bitset.
+ * @var Domains::bits
+ * Domain of each node of G1, `words` words per node.
+ * @var Domains::initial
+ * Initial domain of each node of G1, NULL when it is its class.
+ * @var Domains::trail
+ * Words changed by the pairs currently mapped, in the order of the changes.
+ * @var Domains::trail_size
+ * Number of changes in `trail`.
+ * @var Domains::trail_capacity
+ * Maximum number of changes in `trail`.
+ * @var Domains::levels
+ * Changes made by the pair mapped at each depth.
+ * @var Domains::depth
+ * Number of pairs currently mapped.
+ */
+typedef struct {
+    int num_nodes;
+    int words;
+    uint64_t* bits;
+    uint64_t* initial;
+    DomainChange* trail;
+    int trail_size;
+    int trail_capacity;
+    DomainLevel* levels;
+    int depth;
+} Domains;
+
+/**
+ * @brief This function allocates the domains of an empty mapping: the domain of every node is its class.
+ *
+ * @param domains Pointer to the domains to be initialized.
+ * @param G1 Pointer to G1 graph.
+ * @param filter Pointer to the bitsets of the classes of G2.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool init_domains(Domains* domains, Graph* G1, const CandidateFilter* filter);
+
+/**
+ * @brief Frees up the memory allocated for the domains and the trail.
+ *
+ * @param domains Pointer to the domains to be freed.
+ */
+void free_domains(Domains* domains);
+
+/**
+ * @brief This function narrows the domains when the pair (u, v) is mapped: the domain of every unmapped neighbor of u is ANDed
+ *        with the neighbors of v.
+ *
+ * @param domains Pointer to the domains.
+ * @param G1 Pointer to G1 graph, with u already mapped.
+ * @param adjacency2 Adjacency bitsets of G2.
+ * @param u The node of G1 mapped.
+ * @param v Its image.
+ * @param T2 Bitset of the unmapped nodes of G2 with a mapped neighbor, after the mapping.
+ * @param order Pointer to the keys of the dynamic order, updated with the domains; NULL with the static order.
+ * @return -1 on success, otherwise a neighbor of u left without candidates. Either way the pair must be removed with
+ *         `restore_domains`.
+ */
+int narrow_domains(Domains* domains, Graph* G1, const uint64_t* adjacency2, int u, int v, const uint64_t* T2, DynamicOrder* order);
+
+/**
+ * @brief This function undoes `narrow_domains` when the node u, the last one mapped, is removed from the mapping.
+ *
+ * @param domains Pointer to the domains.
+ * @param G1 Pointer to G1 graph, with u already unmapped.
+ * @param filter Pointer to the bitsets of the classes of G2.
+ * @param adjacency2 Adjacency bitsets of G2.
+ * @param u The node of G1 unmapped.
+ * @param T1 Bitset of the unmapped nodes of G1 with a mapped neighbor, after the removal.
+ * @param T2 Bitset of the unmapped nodes of G2 with a mapped neighbor, after the removal.
+ * @param order Pointer to the keys of the dynamic order, updated with the domains; NULL with the static order.
+ */
+void restore_domains(Domains* domains, Graph* G1, const CandidateFilter* filter, const uint64_t* adjacency2, int u, const uint64_t* T1, const uint64_t* T2, DynamicOrder* order);
+
+/**
+ * @brief This function removes a node of G2 from the domain of an unmapped node of G1, with the changes of the last pair
+ *        mapped, so that `restore_domains` puts it back when that pair is unmapped.
+ *
+ * The removal is only a pruning: it is skipped when it cannot be undone, i.e. when the trail is full or the changes of the
+ * last pair overflowed it (they are then undone by recomputing the domains of its neighbors only).
+ *
+ * @param domains Pointer to the domains, with at least one pair mapped.
+ * @param u The node of G1.
+ * @param v The node of G2 removed from the domain of u.
+ * @return True if v has been removed, false if the removal has been skipped.
+ */
+bool remove_domain_value(Domains* domains, int u, int v);
+
+/**
+ * @brief This function returns the next candidate of an unmapped node, scanning its domain from a position.
+ *
+ * @param domains Pointer to the domains.
+ * @param u The node of G1.
+ * @param pool T2 when u is in T1, T2_tilde otherwise.
+ * @param from First node of G2 that can be returned.
+ * @return The first candidate not below `from`, -1 if there is none.
+ */
+int next_domain_candidate(const Domains* domains, int u, const uint64_t* pool, int from);
+
+#endif // DOMAINS_H
@@ -0,0 +1,119 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file dynamic_order.h
+ * @brief This file defines the keys of the nodes of G1 used to choose the next node of the search dynamically (fail-first).
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - find_candidates.h: Definition of the classes of the nodes.
+ */
+
+#ifndef DYNAMIC_ORDER_H
+#define DYNAMIC_ORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+#include "find_candidates.h"
+
+/**
+ * @struct DynamicOrder
+ * @brief This structure contains the key of each node of G1 and a tournament tree that finds the unmapped node with the
+ *        smallest one.
+ *
+ * The key of a node of T1 is the number of its candidates, its domain AND T2 (see domains.h). The domains change only for the
+ * neighbors of the node mapped or unmapped, so the keys of the other nodes may count nodes mapped since they were computed:
+ * they are upper bounds, exact for the neighbors. Every node of T1 comes before every node of T1_tilde, which are ordered by the
+ * size of their class, so that the search stays connected, as with the static order. Ties are broken by the static order.
+ *
+ * @var DynamicOrder::num_nodes
+ * Number of nodes of the graphs.
+ * @var DynamicOrder::key
+ * Key of each node of G1: the number of its candidates in T1, `num_nodes` + the size of its class in T1_tilde (0 if the class
+ * is empty), INT_MAX when it is mapped.
+ * @var DynamicOrder::tilde_key
+ * Key of each node of G1 when it is in T1_tilde, computed once.
+ * @var DynamicOrder::rank
+ * Position of each node in the static order, used to break the ties.
+ * @var DynamicOrder::node_at
+ * Node at each position of the static order.
+ * @var DynamicOrder::leaves
+ * Number of leaves of the tournament tree: the smallest power of two not below `num_nodes`.
+ * @var DynamicOrder::tree
+ * Tournament tree of the priorities of the nodes, the key in the high half and the rank in the low half: `tree[leaves + u]` is
+ * the priority of u (UINT64_MAX past the last node) and every inner node holds the smaller priority of its two children, so
+ * `tree[1]` is the priority of the node with the smallest key.
+ */
+typedef struct {
+    int num_nodes;
+    int* key;
+    int* tilde_key;
+    int* rank;
+    int* node_at;
+    int leaves;
+    uint64_t* tree;
+} DynamicOrder;
+
+/**
+ * @brief This function allocates the keys of an empty mapping: every node is in T1_tilde.
+ *
+ * @param order Pointer to the structure to be initialized.
+ * @param G1 Pointer to G1 graph.
+ * @param filter Pointer to the bitsets of the classes of G2.
+ * @param node_order Static order of the nodes of G1, used to break the ties.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool init_dynamic_order(DynamicOrder* order, Graph* G1, const CandidateFilter* filter, const int* node_order);
+
+/**
+ * @brief Frees up the memory allocated for the keys and the tree.
+ *
+ * @param order Pointer to the structure to be freed.
+ */
+void free_dynamic_order(DynamicOrder* order);
+
+/**
+ * @brief This function changes the key of a node, in O(log num_nodes).
+ *
+ * @param order Pointer to the keys.
+ * @param u The node of G1.
+ * @param key Its new key: INT_MAX when it is mapped.
+ */
+void set_node_key(DynamicOrder* order, int u, int key);
+
+/**
+ * @brief This function returns the unmapped node of G1 with the smallest key, in constant time.
+ *
+ * @param order Pointer to the keys.
+ * @return The node, -1 if every node is mapped.
+ */
+int select_node(const DynamicOrder* order);
+
+#endif // DYNAMIC_ORDER_H
@@ -0,0 +1,151 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file enumerate.h
+ * @brief This file defines the functions used to enumerate or count all the mappings between two graphs, and a binary writer to stream the mappings to a file.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - vf2pp.h: Definition of the resumable VF2++ search.
+ */
+
+#ifndef ENUMERATE_H
+#define ENUMERATE_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+#include "vf2pp.h"
+
+/* First bytes of a binary mappings file */
+#define MAPPING_FILE_MAGIC "VF2M"
+
+/**
+ * @brief Function called for each mapping found during an enumeration.
+ *
+ * @param mapping Array with the image in `G2` of each node of `G1`. It is only valid during the call.
+ * @param num_nodes Number of nodes of `G1`.
+ * @param user_data Pointer passed unchanged from `EnumerationOptions::user_data`.
+ * @return True to continue the enumeration, false to stop it.
+ */
+typedef bool (*MappingCallback)(const int* mapping, int num_nodes, void* user_data);
+
+/**
+ * @struct EnumerationOptions
+ * @brief This structure contains the options of an enumeration.
+ *
+ * @var EnumerationOptions::max_mappings
+ * Maximum number of mappings to be found; 0 means no limit.
+ * @var EnumerationOptions::count_only
+ * When true the mappings are only counted: they are not copied and the callback is never called.
+ * @var EnumerationOptions::callback
+ * Function called for each mapping found, or NULL.
+ * @var EnumerationOptions::user_data
+ * Pointer passed to the callback.
+ * @var EnumerationOptions::search
+ * Options of the underlying VF2++ search, NULL for the default ones. Symmetry breaking and the endgame are always disabled, since
+ * they skip mappings.
+ */
+typedef struct {
+    long max_mappings;
+    bool count_only;
+    MappingCallback callback;
+    void* user_data;
+    const VF2ppOptions* search;
+} EnumerationOptions;
+
+/**
+ * @struct MappingWriter
+ * @brief This structure streams mappings to a binary file.
+ *
+ * The file starts with the 4 bytes of `MAPPING_FILE_MAGIC`, followed by the number of nodes (int32) and the number of mappings (int64, -1 if the file was not seekable);
+ * then each mapping is stored as `num_nodes` int32 values, in the byte order of the machine.
+ *
+ * @var MappingWriter::file
+ * File where the mappings are written.
+ * @var MappingWriter::num_nodes
+ * Number of nodes of each mapping.
+ * @var MappingWriter::count
+ * Number of mappings written so far.
+ */
+typedef struct {
+    FILE* file;
+    int32_t num_nodes;
+    int64_t count;
+} MappingWriter;
+
+/**
+ * @brief This function finds all the mappings between G1 and G2 in a single search.
+ *
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param options Pointer to the enumeration options.
+ * @return The number of mappings found.
+ */
+long vf2pp_enumerate(Graph* G1, Graph* G2, const EnumerationOptions* options);
+
+/**
+ * @brief This function opens a binary file and writes its header.
+ *
+ * @param filename Path of the file to be created.
+ * @param num_nodes Number of nodes of each mapping.
+ * @return Pointer to the writer, or NULL if the file cannot be created.
+ */
+MappingWriter* mapping_writer_open(const char* filename, int num_nodes);
+
+/**
+ * @brief This function appends a mapping to the binary file. It has the signature of a `MappingCallback`, so it can be used directly in an enumeration.
+ *
+ * @param mapping Array with the image in `G2` of each node of `G1`.
+ * @param num_nodes Number of nodes of `G1`.
+ * @param writer Pointer to a `MappingWriter`.
+ * @return True if the mapping has been written, false otherwise (the enumeration is stopped).
+ */
+bool mapping_writer_write(const int* mapping, int num_nodes, void* writer);
+
+/**
+ * @brief This function updates the number of mappings in the header, closes the file and frees the writer.
+ *
+ * @param writer Pointer to the writer to be closed.
+ */
+void mapping_writer_close(MappingWriter* writer);
+
+/**
+ * @brief This function reads the first mapping of a binary file written by a `MappingWriter`, for instance to reuse it as the
+ *        hint of a value ordering (see value_order.h).
+ *
+ * @param filename Path of the file.
+ * @param num_nodes Number of nodes of each mapping, which must match the header of the file.
+ * @param mapping Array of `num_nodes` elements filled with the mapping.
+ * @return True if the mapping has been read, false otherwise (an error is printed).
+ */
+bool mapping_file_read(const char* filename, int num_nodes, int* mapping);
+
+#endif // ENUMERATE_H
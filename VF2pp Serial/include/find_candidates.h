@@ -32,32 +32,87 @@
  * @dependencies
  * This module depends on the following files:
  * - graph.h: Definition of graph structure.
+ * - bitset.h: Definition of the bitsets used to intersect the neighborhoods.
  */
 #ifndef FIND_CANDIDATES_H
 #define FIND_CANDIDATES_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "graph.h"
+#include "bitset.h"
+
+/* Largest graph whose candidates are found with bitsets: the adjacency bitsets take num_nodes^2 / 8 bytes */
+#define CANDIDATE_BITSET_MAX_NODES 16384
 
 /**
- * @brief This function finds candidates for the `u` node of a graph.
+ * @struct CandidateFilter
+ * @brief This structure contains the bitsets of `G2` used to intersect the neighborhoods of the mapped neighbors of a node.
  *
+ * @var CandidateFilter::words
+ * Number of words of each bitset.
+ * @var CandidateFilter::adjacency
+ * Adjacency bitsets of `G2`, owned by the graph.
+ * @var CandidateFilter::class_bits
+ * One bitset for each class of `G2`, with the nodes of that class. The nodes are classified by signature when both graphs
+ * have their signatures (see signature.h), by degree otherwise.
+ * @var CandidateFilter::node_class
+ * Index in `class_bits` of the class of each node of `G1`, -1 if no node of `G2` is in that class.
+ */
+typedef struct {
+    int words;
+    uint64_t* adjacency;
+    uint64_t* class_bits;
+    int* node_class;
+} CandidateFilter;
+
+/* Pivot of a node with no mapped neighbor: its candidates are scanned in T2_tilde */
+#define PIVOT_NONE -1
+/* Pivot of a node with several mapped neighbors, when the bitsets are available: its candidates are computed word by word */
+#define PIVOT_BITSETS -2
+
+/**
+ * @brief This function prepares the scan of the candidates of the `u` node, choosing how they are found.
  * @param u Index of the node in the `G1` graph.
  * @param G1 Pointer to G1 graph.
  * @param G2 Pointer to G2 graph.
- * @param size_candidates Pointer to an integer representing the number of candidates found.
- * @param T2_tilde Boolean array indicating which nodes in `G2` are unmapped and are not neighbors of mapped nodes.
- * @return Pointer to an array containing the indexes of candidate nodes.
+ * @param filter Pointer to the bitsets of `G2`, NULL to intersect the neighbor lists instead.
+ * @return `PIVOT_NONE` if `u` has no mapped neighbor, `PIVOT_BITSETS` if it has several and `filter` is not NULL, otherwise the
+ *         image of its mapped neighbor with the smallest degree, whose neighbors are scanned.
  */
-int* _find_candidates(int u, Graph* G1, Graph* G2, int* size_candidates, bool* T2_tilde);
+int candidate_pivot(int u, Graph* G1, Graph* G2, const CandidateFilter* filter);
 
 /**
- * @brief Comparison function for sorting. Compares two nodes by the number of neighbors. Used in `qsort`.
- *
- * @param a Pointer to the first node.
- * @param b Pointer to the second node.
- * @return A negative value if the first node has fewer neighbors, positive if it has more, 0 if they are equal.
+ * @brief This function finds the next candidate of the `u` node, without allocating memory: only the candidates asked for are
+ *        computed, in the order of the scan.
+ * Every candidate has the signature of `u` when both graphs have their signatures, the degree of `u` otherwise.
+ * The mapped neighbors of `u`, T2 and T2_tilde must be the same as when the pivot was chosen.
+ * @param u Index of the node in the `G1` graph.
+ * @param pivot The pivot returned by `candidate_pivot`.
+ * @param cursor Position of the scan, 0 at the beginning: a node of `G2`, or a position in the neighbors of the pivot; it is
+ *               moved past the candidate returned.
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param T2 Bitset of the nodes of `G2` that are unmapped and are neighbors of mapped nodes.
+ * @param T2_tilde Bitset of the nodes of `G2` that are unmapped and are not neighbors of mapped nodes.
+ * @param filter Pointer to the bitsets of `G2`, NULL to intersect the neighbor lists instead.
+ * @return The next candidate, -1 when every candidate has been returned.
+ */
+int next_candidate(int u, int pivot, int* cursor, Graph* G1, Graph* G2, const uint64_t* T2, const uint64_t* T2_tilde, const CandidateFilter* filter);
+
+/**
+ * @brief This function builds the bitsets used by `next_candidate`, classifying the nodes by signature when both graphs have their signatures.
+ * @param filter Pointer to the filter to be initialized.
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @return True if the filter has been built, false if `G2` is too large or memory cannot be allocated.
+ */
+bool init_candidate_filter(CandidateFilter* filter, Graph* G1, Graph* G2);
+
+/**
+ * @brief Frees up the memory allocated for the filter; the adjacency bitsets stay with the graph.
+ * @param filter Pointer to the filter to be freed.
  */
-int comparator(const void* a, const void* b);
+void free_candidate_filter(CandidateFilter* filter);
 
 #endif // FIND_CANDIDATES_H
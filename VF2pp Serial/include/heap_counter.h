@@ -0,0 +1,46 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file heap_counter.h
+ * @brief This file defines the counter of the heap calls made by the program, used to check that the search does not allocate memory.
+ *
+ * The counter is enabled by building with `make COUNT_ALLOCS=1`: the linker then wraps malloc, calloc, realloc and free,
+ * so that every call made by the program goes through the counting functions of heap_counter.c.
+ */
+
+#ifndef HEAP_COUNTER_H
+#define HEAP_COUNTER_H
+
+/**
+ * @brief This function returns the number of heap calls (malloc, calloc, realloc and free) made by the program so far.
+ *
+ * @return The number of heap calls, or -1 if the program has been built without `COUNT_ALLOCS=1`.
+ */
+long heap_calls(void);
+
+#endif // HEAP_COUNTER_H
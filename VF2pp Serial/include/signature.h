@@ -0,0 +1,81 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file signature.h
+ * @brief This file defines the structural signatures of the nodes, used to discard candidate pairs before the search.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ */
+
+#ifndef SIGNATURE_H
+#define SIGNATURE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+
+/**
+ * @brief This function returns the structural signature of every node of a graph, computing and caching it the first time.
+ *
+ * The signature of a node hashes its degree, the number of triangles through it, the multiset of the degrees of its neighbors
+ * and the number of nodes at distance 1 or 2. All of them are preserved by isomorphisms, so a node of G1 can be mapped to a
+ * node of G2 only if their signatures are equal (the converse does not hold: equal signatures do not imply a valid pair).
+ * The counts are computed with bitset intersections when the graph is small enough for its adjacency bitsets, and the nodes
+ * are processed in parallel when the program is built with OpenMP.
+ *
+ * @param g Pointer to the graph.
+ * @return Array of `g->num_nodes` signatures owned by the graph, or NULL if memory cannot be allocated.
+ */
+uint64_t* graph_signatures(Graph* g);
+
+/**
+ * @brief This function checks whether two graphs have the same multiset of node signatures, a necessary condition for isomorphism.
+ *
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph, with the same number of nodes as `G1`.
+ * @return False if the graphs cannot be isomorphic, true otherwise (also when the signatures cannot be computed).
+ */
+bool signatures_compatible(Graph* G1, Graph* G2);
+
+/**
+ * @brief This function sets the node keys of a graph from labels given by the caller, so that the search maps a node only to a node
+ *        with the same label.
+ *
+ * The key of a node (stored as its signature, see find_candidates.h) has the label in the high 32 bits and, in the low ones, the low
+ * 32 bits of the structural signature (when `signatures` is true) or the degree. Labels must be non-negative.
+ *
+ * @param g Pointer to the graph.
+ * @param label Label of each node of the graph.
+ * @param signatures True to combine the labels with the structural signatures.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool set_label_keys(Graph* g, const int* label, bool signatures);
+
+#endif // SIGNATURE_H
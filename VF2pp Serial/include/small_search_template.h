@@ -0,0 +1,205 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file small_search_template.h
+ * @brief This file is the template of the VF2++ search on small graphs, included by small_search.c once for each width of the sets of nodes.
+ *
+ * Before each inclusion SMALL_WIDTH is defined as 64 or 128, along with the type SmallW of a set of at most W nodes and its
+ * operations smallW_none, smallW_bit, smallW_or, smallW_and, smallW_andnot, smallW_empty, smallW_count and smallW_lowest, and
+ * _compare_keys orders two keys for qsort and bsearch; the inclusion defines smallW_search. The file has no include guard, since it is meant to be included more than once.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - vf2pp.h: Definition of the statistics of the search.
+ */
+
+#ifndef SMALL_WIDTH
+#error "SMALL_WIDTH must be defined before including small_search_template.h"
+#endif
+
+#define SMALL_CAT_(a, b) a##b
+#define SMALL_CAT(a, b) SMALL_CAT_(a, b)
+/* Type of a set of nodes and name of its operation `name` for the current width */
+#define SMALL_SET SMALL_CAT(Small, SMALL_WIDTH)
+#define SMALL_FN(name) SMALL_CAT(SMALL_CAT(small, SMALL_WIDTH), name)
+
+/**
+ * Searches a mapping of G1 to G2, which have n <= SMALL_WIDTH nodes, following `order`.
+ * 1. Builds the adjacency rows of both graphs (of their complements when `complemented`, every other node but the node itself)
+ *    and, for each node u of G1, the set of the nodes of G2 with its key (signature when `signatures`, degree otherwise): the
+ *    distinct keys of G2 are sorted, and each node of G1 takes the set of its key, found with a binary search (_compare_keys).
+ * 2. At each depth, the candidates of the node u of that depth are computed once, when the depth is reached: the nodes of G2
+ *    with its key, not mapped, adjacent to the images of all the mapped neighbors of u (the AND of their rows), or in T2_tilde
+ *    when u has no mapped neighbor.
+ * 3. The lowest candidate v is taken and removed; the pair is rejected unless u and v have as many mapped neighbors (so v has no
+ *    other mapped neighbor) and as many neighbors in T1 and T2 (the cut rule of _cut_reason in vf2pp.c).
+ * 4. An accepted pair saves T1 and T2 for its depth, adds u and v to the mapped nodes and their unmapped neighbors to T1 and T2,
+ *    and goes one depth deeper; when the candidates of a depth run out, the search goes back one depth and undoes its pair by
+ *    restoring the saved sets.
+ * 5. The mapping found is copied to the `mapped` fields. Returns 1 if a mapping was found, 0 otherwise (or when more than
+ *    `max_states` states, if positive, would be explored).
+ */
+static int SMALL_FN(_search)(Graph* G1, Graph* G2, const int* order, bool complemented, bool signatures, long max_states, VF2ppStats* stats) {
+    int n = G1->num_nodes;
+    SMALL_SET adjacency1[SMALL_WIDTH];
+    SMALL_SET adjacency2[SMALL_WIDTH];
+    SMALL_SET same_key[SMALL_WIDTH];
+    SMALL_SET candidates[SMALL_WIDTH];
+    SMALL_SET saved_T1[SMALL_WIDTH];
+    SMALL_SET saved_T2[SMALL_WIDTH];
+    bool fresh[SMALL_WIDTH];
+    int image[SMALL_WIDTH];
+
+    SMALL_SET all = SMALL_FN(_none)();
+    for (int x = 0; x < n; x++) {
+        all = SMALL_FN(_or)(all, SMALL_FN(_bit)(x));
+    }
+    for (int x = 0; x < n; x++) {
+        SMALL_SET row1 = SMALL_FN(_none)();
+        SMALL_SET row2 = SMALL_FN(_none)();
+        for (int i = 0; i < G1->nodes[x].num_neighbors; i++) {
+            row1 = SMALL_FN(_or)(row1, SMALL_FN(_bit)(G1->nodes[x].neighborhood[i]));
+        }
+        for (int i = 0; i < G2->nodes[x].num_neighbors; i++) {
+            row2 = SMALL_FN(_or)(row2, SMALL_FN(_bit)(G2->nodes[x].neighborhood[i]));
+        }
+        if (complemented) {
+            row1 = SMALL_FN(_andnot)(all, SMALL_FN(_or)(row1, SMALL_FN(_bit)(x)));
+            row2 = SMALL_FN(_andnot)(all, SMALL_FN(_or)(row2, SMALL_FN(_bit)(x)));
+        }
+        adjacency1[x] = row1;
+        adjacency2[x] = row2;
+    }
+    uint64_t keys[SMALL_WIDTH];
+    SMALL_SET class_sets[SMALL_WIDTH];
+    for (int v = 0; v < n; v++) {
+        keys[v] = signatures ? G2->signature[v] : (uint64_t)G2->nodes[v].num_neighbors;
+    }
+    qsort(keys, n, sizeof(uint64_t), _compare_keys);
+    int num_classes = 0;
+    for (int i = 0; i < n; i++) {
+        if (i == 0 || keys[i] != keys[num_classes - 1]) {
+            class_sets[num_classes] = SMALL_FN(_none)();
+            keys[num_classes++] = keys[i];
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        uint64_t key = signatures ? G2->signature[v] : (uint64_t)G2->nodes[v].num_neighbors;
+        const uint64_t* found = (const uint64_t*)bsearch(&key, keys, num_classes, sizeof(uint64_t), _compare_keys);
+        class_sets[found - keys] = SMALL_FN(_or)(class_sets[found - keys], SMALL_FN(_bit)(v));
+    }
+    for (int u = 0; u < n; u++) {
+        uint64_t key = signatures ? G1->signature[u] : (uint64_t)G1->nodes[u].num_neighbors;
+        const uint64_t* found = (const uint64_t*)bsearch(&key, keys, num_classes, sizeof(uint64_t), _compare_keys);
+        same_key[u] = (found != NULL) ? class_sets[found - keys] : SMALL_FN(_none)();
+        image[u] = -1;
+    }
+
+    SMALL_SET mapped1 = SMALL_FN(_none)();
+    SMALL_SET mapped2 = SMALL_FN(_none)();
+    SMALL_SET T1 = SMALL_FN(_none)();
+    SMALL_SET T2 = SMALL_FN(_none)();
+    long num_states = 0;
+    long first_choices = 0;
+    int result = 0;
+    int depth = 0;
+    candidates[0] = same_key[order[0]];
+    fresh[0] = true;
+    while (depth >= 0) {
+        int u = order[depth];
+        if (image[u] != -1) {
+            mapped1 = SMALL_FN(_andnot)(mapped1, SMALL_FN(_bit)(u));
+            mapped2 = SMALL_FN(_andnot)(mapped2, SMALL_FN(_bit)(image[u]));
+            T1 = saved_T1[depth];
+            T2 = saved_T2[depth];
+            image[u] = -1;
+        }
+        if (SMALL_FN(_empty)(candidates[depth])) {
+            depth--;
+            continue;
+        }
+        int v = SMALL_FN(_lowest)(candidates[depth]);
+        candidates[depth] = SMALL_FN(_andnot)(candidates[depth], SMALL_FN(_bit)(v));
+        bool first = fresh[depth];
+        fresh[depth] = false;
+        if (SMALL_FN(_count)(SMALL_FN(_and)(adjacency1[u], mapped1)) != SMALL_FN(_count)(SMALL_FN(_and)(adjacency2[v], mapped2))
+            || SMALL_FN(_count)(SMALL_FN(_and)(adjacency1[u], T1)) != SMALL_FN(_count)(SMALL_FN(_and)(adjacency2[v], T2))) {
+            continue;
+        }
+        num_states++;
+        first_choices += first;
+        if (max_states > 0 && num_states > max_states) {
+            break;
+        }
+        image[u] = v;
+        if (depth == n - 1) {
+            result = 1;
+            break;
+        }
+        saved_T1[depth] = T1;
+        saved_T2[depth] = T2;
+        mapped1 = SMALL_FN(_or)(mapped1, SMALL_FN(_bit)(u));
+        mapped2 = SMALL_FN(_or)(mapped2, SMALL_FN(_bit)(v));
+        T1 = SMALL_FN(_andnot)(SMALL_FN(_or)(T1, adjacency1[u]), mapped1);
+        T2 = SMALL_FN(_andnot)(SMALL_FN(_or)(T2, adjacency2[v]), mapped2);
+
+        depth++;
+        int next = order[depth];
+        SMALL_SET pool = SMALL_FN(_andnot)(same_key[next], mapped2);
+        SMALL_SET covered = SMALL_FN(_and)(adjacency1[next], mapped1);
+        if (SMALL_FN(_empty)(covered)) {
+            pool = SMALL_FN(_andnot)(pool, T2);
+        }
+        while (!SMALL_FN(_empty)(covered) && !SMALL_FN(_empty)(pool)) {
+            int w = SMALL_FN(_lowest)(covered);
+            covered = SMALL_FN(_andnot)(covered, SMALL_FN(_bit)(w));
+            pool = SMALL_FN(_and)(pool, adjacency2[image[w]]);
+        }
+        candidates[depth] = pool;
+        fresh[depth] = true;
+    }
+
+    for (int x = 0; x < n; x++) {
+        G1->nodes[x].mapped = result ? image[x] : -1;
+        G2->nodes[x].mapped = -1;
+    }
+    if (result) {
+        for (int x = 0; x < n; x++) {
+            G2->nodes[image[x]].mapped = x;
+        }
+    }
+    stats->num_states = num_states;
+    stats->first_choices = first_choices;
+    return result;
+}
+
+#undef SMALL_FN
+#undef SMALL_SET
+#undef SMALL_CAT
+#undef SMALL_CAT_
@@ -0,0 +1,193 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file symmetry.h
+ * @brief This file defines the data structures and functions used to detect the symmetries (automorphisms) of a graph and to break them during the search.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ */
+
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include <stdbool.h>
+#include "graph.h"
+
+/* Default limits of the automorphism search performed by `compute_symmetry` */
+#define SYMMETRY_MAX_GENERATORS 64
+#define SYMMETRY_MAX_STATES 200000
+
+/**
+ * @struct Symmetry
+ * @brief This structure contains a partial automorphism group of a graph and the orbits it generates.
+ *
+ * Two kinds of automorphisms are stored:
+ * - twin classes: nodes with the same open (N(u)) or closed (N(u) + u) neighborhood; every transposition of two twins is an automorphism;
+ * - generators: automorphisms found by a bounded VF2++ search of the graph against itself, stored as permutations.
+ *
+ * @var Symmetry::num_nodes
+ * Number of nodes of the graph.
+ * @var Symmetry::twin_class
+ * Twin class of each node (the smallest node of the class).
+ * @var Symmetry::twin_next
+ * Next node of the same twin class, -1 for the last one: every class is a list starting from `twin_class`.
+ * @var Symmetry::generators
+ * Array of `num_generators` permutations of `num_nodes` elements.
+ * @var Symmetry::num_generators
+ * Number of generators found.
+ * @var Symmetry::orbit
+ * Orbit of each node (the smallest node of the orbit) under the group generated by twins and generators.
+ * @var Symmetry::num_orbits
+ * Number of orbits.
+ */
+typedef struct Symmetry {
+    int num_nodes;
+    int* twin_class;
+    int* twin_next;
+    int** generators;
+    int num_generators;
+    int* orbit;
+    int num_orbits;
+} Symmetry;
+
+/**
+ * @struct ForbiddenPairs
+ * @brief This structure stores the pairs (node of G1, node of G2) that cannot be part of a mapping extending the current partial mapping.
+ *
+ * The pairs are stored in a stack, each one tagged with the depth of the search where it was found, so that they are discarded when the search backtracks above that depth.
+ *
+ * @var ForbiddenPairs::head
+ * Index of the last pair added for each node of G1, -1 if there is none.
+ * @var ForbiddenPairs::node
+ * Node of G1 of each pair.
+ * @var ForbiddenPairs::value
+ * Node of G2 of each pair.
+ * @var ForbiddenPairs::depth
+ * Depth of the search where each pair was added.
+ * @var ForbiddenPairs::next
+ * Previous pair of the same node of G1, -1 if there is none.
+ * @var ForbiddenPairs::size
+ * Number of pairs stored.
+ * @var ForbiddenPairs::capacity
+ * Current capacity of the arrays of pairs.
+ */
+typedef struct {
+    int* head;
+    int* node;
+    int* value;
+    int* depth;
+    int* next;
+    int size;
+    int capacity;
+} ForbiddenPairs;
+
+/**
+ * @brief This function detects the twin classes of a graph and searches a bounded number of its automorphisms.
+ *
+ * @param g Pointer to the graph.
+ * @param max_generators Maximum number of automorphisms stored as generators.
+ * @param max_states Maximum number of states explored by the automorphism search.
+ * @return Pointer to the symmetry data, or NULL if memory cannot be allocated.
+ */
+Symmetry* compute_symmetry(Graph* g, int max_generators, long max_states);
+
+/**
+ * @brief This function returns the symmetry data cached with the graph, computing them with the default limits the first time.
+ *
+ * @param g Pointer to the graph.
+ * @return Pointer to the symmetry data owned by the graph.
+ */
+Symmetry* graph_symmetry(Graph* g);
+
+/**
+ * @brief Frees up the memory allocated for the symmetry data. NULL is accepted.
+ *
+ * @param sym Pointer to the symmetry data.
+ */
+void free_symmetry(Symmetry* sym);
+
+/**
+ * @brief This function computes the nodes that an automorphism fixing every mapped node of `G1` can map `node` to.
+ *
+ * Only twins and generators that fix every mapped node are used, so the result is a subset of the orbit of `node` in the pointwise stabilizer of the mapped nodes.
+ *
+ * @param sym Pointer to the symmetry data of `G1`.
+ * @param G1 Pointer to G1 graph, whose `mapped` fields describe the current partial mapping.
+ * @param node Node of `G1`, not mapped.
+ * @param orbit Array of at least `G1->num_nodes` elements filled with the nodes found, `node` excluded.
+ * @param visited Array of `G1->num_nodes` booleans, all false; it is left all false.
+ * @return The number of nodes stored in `orbit`.
+ */
+int stabilizer_orbit(Symmetry* sym, Graph* G1, int node, int* orbit, bool* visited);
+
+/**
+ * @brief This function initializes an empty set of forbidden pairs.
+ *
+ * @param pairs Pointer to the set to be initialized.
+ * @param num_nodes Number of nodes of G1.
+ */
+void init_forbidden_pairs(ForbiddenPairs* pairs, int num_nodes);
+
+/**
+ * @brief This function adds a forbidden pair.
+ *
+ * @param pairs Pointer to the set of forbidden pairs.
+ * @param node Node of G1.
+ * @param value Node of G2 that `node` cannot be mapped to.
+ * @param depth Depth of the search where the pair has been found.
+ */
+void add_forbidden_pair(ForbiddenPairs* pairs, int node, int value, int depth);
+
+/**
+ * @brief This function checks whether a pair is forbidden.
+ *
+ * @param pairs Pointer to the set of forbidden pairs.
+ * @param node Node of G1.
+ * @param value Node of G2.
+ * @return True if `node` cannot be mapped to `value`.
+ */
+bool is_forbidden_pair(ForbiddenPairs* pairs, int node, int value);
+
+/**
+ * @brief This function discards the pairs found at a depth greater than or equal to `depth`.
+ *
+ * @param pairs Pointer to the set of forbidden pairs.
+ * @param depth Depth of the search the pairs are discarded from.
+ */
+void backtrack_forbidden_pairs(ForbiddenPairs* pairs, int depth);
+
+/**
+ * @brief Frees up the memory allocated for the set of forbidden pairs.
+ *
+ * @param pairs Pointer to the set to be freed.
+ */
+void free_forbidden_pairs(ForbiddenPairs* pairs);
+
+#endif // SYMMETRY_H
@@ -0,0 +1,113 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file twins.h
+ * @brief This file defines the twin classes of a graph and the isomorphism test that runs VF2++ on the quotient graphs, with one node per class.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - vf2pp.h: Definition of the VF2++ search run on the quotient graphs.
+ */
+
+#ifndef TWINS_H
+#define TWINS_H
+
+#include <stdbool.h>
+#include "graph.h"
+#include "vf2pp.h"
+
+/* Kinds of twin classes */
+#define TWIN_SINGLE 0
+#define TWIN_OPEN 1
+#define TWIN_CLOSED 2
+
+/**
+ * @struct TwinClasses
+ * @brief This structure contains the twin classes of a graph: the nodes with the same open neighborhood N(u) (false twins, never
+ *        adjacent to each other) and, among the others, the nodes with the same closed neighborhood N(u) + u (true twins, all adjacent).
+ *
+ * @var TwinClasses::num_classes
+ * Number of classes, including those with a single node.
+ * @var TwinClasses::class_of
+ * Class of each node.
+ * @var TwinClasses::start
+ * Position in `members` of the first node of each class; it has `num_classes + 1` elements.
+ * @var TwinClasses::members
+ * Nodes grouped by class.
+ * @var TwinClasses::kind
+ * Kind of each class: TWIN_SINGLE, TWIN_OPEN or TWIN_CLOSED.
+ */
+typedef struct {
+    int num_classes;
+    int* class_of;
+    int* start;
+    int* members;
+    int* kind;
+} TwinClasses;
+
+/**
+ * @brief This function finds the twin classes of a graph without self loops.
+ *
+ * The nodes are grouped by a hash of their neighborhood that does not depend on the order of the neighbors (computed on the
+ * adjacency bitsets for dense graphs) and the nodes with the same hash are compared exactly, so the classes are the same for
+ * isomorphic graphs. The time is O(n log n + m).
+ *
+ * @param g Pointer to the graph.
+ * @param twins Pointer to the classes to be filled.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool find_twin_classes(Graph* g, TwinClasses* twins);
+
+/**
+ * @brief Frees up the memory allocated for the twin classes.
+ *
+ * @param twins Pointer to the classes to be freed.
+ */
+void free_twin_classes(TwinClasses* twins);
+
+/**
+ * @brief This function checks whether two graphs are isomorphic by matching their quotient graphs, when G1 has twins.
+ *
+ * The twins of a class are interchangeable, so the search would try every permutation of them after a failure: the quotient
+ * graph has one node per class, labeled with its kind and size, and two classes are adjacent when their nodes are. The graphs are
+ * isomorphic exactly when the quotients are, by a mapping that preserves the labels; VF2++ runs on the quotients with the labels
+ * in the node keys, and the mapping is expanded matching the nodes of each pair of classes in order. Symmetry breaking is disabled,
+ * since the automorphisms of a quotient do not preserve the labels. When the graphs are isomorphic, the `mapped` field of each node
+ * of G1 (G2) contains its image in G2 (G1).
+ *
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param options Pointer to the options of the search of the quotients, NULL for the default ones.
+ * @param stats Pointer filled with the statistics of the search, NULL if they are not needed.
+ * @return 1 if the graphs are isomorphic, 0 if they are not, -1 if G1 has no twins (or self loops, or the graphs have different sizes,
+ *         or memory cannot be allocated) and the search must be run on the whole graphs.
+ */
+int twins_isomorphic(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats);
+
+#endif // TWINS_H
@@ -32,13 +32,340 @@
  * @dependencies
  * This module depends on the following files:
  * - graph.h: Definition of graph structure.
+ * - stack.h: Definition of the stack that stores a node's candidates in order to keep track of mappings.
+ * - find_candidates.h: Definition of the bitsets used to find the candidates.
+ * - symmetry.h: Definition of the symmetry data used by symmetry breaking.
+ * - backjump.h: Definition of the conflict sets used to backjump.
+ * - nogood.h: Definition of the table of failed subproblems.
+ * - domains.h: Definition of the domains narrowed by forward checking.
+ * - dynamic_order.h: Definition of the keys used to choose the next node dynamically.
+ * - all_different.h: Definition of the matching of the all-different propagator.
+ * - value_order.h: Definition of the strategies that order the candidates.
+ * - endgame.h: Definition of the buffers of the endgame.
  */
 
 #ifndef VF2PP_H
 #define VF2PP_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "graph.h"
+#include "stack.h"
+#include "find_candidates.h"
+#include "symmetry.h"
+#include "backjump.h"
+#include "nogood.h"
+#include "domains.h"
+#include "dynamic_order.h"
+#include "all_different.h"
+#include "value_order.h"
+#include "endgame.h"
+
+/* The search runs on the complements of the graphs when more than this fraction of the possible edges is present */
+#define COMPLEMENT_MIN_DENSITY 0.5
+
+/**
+ * @struct VF2ppOptions
+ * @brief This structure contains the optional features of a VF2++ search.
+ *
+ * @var VF2ppOptions::symmetry_breaking
+ * When true the automorphisms of G1 are used to skip the branches equivalent to a branch that already failed.
+ * The automorphisms are computed once and cached with G1. It must be false when all the mappings are needed.
+ * @var VF2ppOptions::max_states
+ * Maximum number of states (candidate assignments) explored by the search; 0 means no limit.
+ * @var VF2ppOptions::signatures
+ * When true the structural signatures of the nodes (see signature.h) are computed, the search is skipped if the two graphs have
+ * different signatures, and a node is matched only to nodes with its signature instead of its degree.
+ * The signatures are cached with the graphs, so every later search between two graphs that have them uses them too.
+ * @var VF2ppOptions::nogoods
+ * When true every failed subproblem is recorded in a bounded table (see nogood.h), and a state whose subproblem has already
+ * failed is not expanded.
+ * @var VF2ppOptions::forward_checking
+ * When true every unmapped node keeps a domain, narrowed after each assignment (see domains.h): a mapping that leaves a node
+ * without candidates is rejected at once, and the candidates are scanned in the domains. It needs the candidate bitsets.
+ * @var VF2ppOptions::dynamic_order
+ * When true the next node matched is chosen at each depth instead of following the static order: the unmapped node with the
+ * fewest candidates (see dynamic_order.h). It implies forward checking, and it disables the table of nogoods, whose subproblems
+ * assume the static order.
+ * @var VF2ppOptions::all_different_period
+ * When positive, every `all_different_period` assignments the candidates of the nodes of T1 are matched (see all_different.h):
+ * the search backtracks when they admit no injective assignment, and the candidates that belong to no such assignment are
+ * removed from the domains. It implies forward checking; 0 disables it.
+ * @var VF2ppOptions::arc_consistency
+ * When true the domains are filtered before the search (see arc_consistency.h): v is left out of the domain of u when some
+ * neighbor of u cannot be mapped to any neighbor of v, to a fixpoint, and the search is skipped when a domain is emptied. It
+ * implies forward checking.
+ * @var VF2ppOptions::value_order
+ * Order in which the candidates of a node are tried: one of the VALUE_ORDER_* strategies (see value_order.h).
+ * VALUE_ORDER_SCAN tries them in the order they are found; the other strategies rank all the candidates left each time one is
+ * tried, so they pay off only when the first candidates found are often wrong.
+ * @var VF2ppOptions::value_hint
+ * Mapping found before between G1 and a similar G2 (the image of each node of G1), used by VALUE_ORDER_LEARNED; NULL if none.
+ * @var VF2ppOptions::value_hint_nodes
+ * Number of elements of `value_hint`: the hint is used only by a search between graphs with that many nodes.
+ * @var VF2ppOptions::endgame_threshold
+ * When positive, once this many nodes are left unmapped they are matched in a single step (see endgame.h) instead of one depth
+ * at a time; at most ENDGAME_MAX_NODES, 0 disables it. The search ends with the mapping found by the endgame, so it must be 0
+ * when all the mappings are needed.
+ * @var VF2ppOptions::fallback_states
+ * When positive, a search of the whole graphs (see vf2pp_is_isomorphic_with_options) that explores more than this many states is
+ * taken as stalled, as on the highly symmetric graphs where the degrees and the frontier prune nothing: the graphs are then
+ * decided by their canonical certificates (individualization-refinement with automorphism pruning, see canonical.h). 0 disables
+ * it; a smaller `max_states` keeps its meaning of a hard limit.
+ * @var VF2ppOptions::seed
+ * Seed of the random choices: when not 0, the ties between nodes of equal degree in the matching order are broken at random
+ * (see matching_order_seeded), and VALUE_ORDER_RANDOM uses it.
+ * @var VF2ppOptions::restart_base
+ * When positive, a search of the whole graphs (see vf2pp_is_isomorphic_with_options) is restarted after restart_base * L(i)
+ * states in its run i, L being Luby's sequence 1, 1, 2, 1, 1, 2, 4, ...: the first run follows the usual order, the next ones
+ * use the seeds derived from `seed` and, when `value_order` is VALUE_ORDER_SCAN, try the candidates in random order. The
+ * statistics carry over between the runs, and so do the nogoods when two runs have the same node order; `max_states` bounds
+ * the states of all the runs. 0 disables it.
+ */
+typedef struct {
+    bool symmetry_breaking;
+    long max_states;
+    bool signatures;
+    bool nogoods;
+    bool forward_checking;
+    bool dynamic_order;
+    int all_different_period;
+    bool arc_consistency;
+    int value_order;
+    const int* value_hint;
+    int value_hint_nodes;
+    int endgame_threshold;
+    long fallback_states;
+    uint64_t seed;
+    long restart_base;
+} VF2ppOptions;
+
+/**
+ * @struct VF2ppStats
+ * @brief This structure contains the statistics of a VF2++ search.
+ *
+ * @var VF2ppStats::num_states
+ * Number of states (candidate assignments) explored.
+ * @var VF2ppStats::heap_calls
+ * Number of heap calls made inside the search loop (`vf2pp_next`), -1 if the program has been built without the heap counter (see heap_counter.h).
+ * @var VF2ppStats::nogood_lookups
+ * Number of states checked against the table of nogoods.
+ * @var VF2ppStats::nogood_hits
+ * Number of states found in the table of nogoods, and not expanded.
+ * @var VF2ppStats::value_order
+ * Strategy that ordered the candidates (see value_order.h): VALUE_ORDER_SCAN when the one requested could not be used.
+ * @var VF2ppStats::first_choices
+ * Number of states that were the first candidate tried for their node.
+ * @var VF2ppStats::endgames
+ * Number of endgames run: each one replaced the search of the last unmapped nodes below a state.
+ * @var VF2ppStats::fallbacks
+ * Number of stalled searches decided by the canonical certificates instead (see VF2ppOptions::fallback_states).
+ * @var VF2ppStats::restarts
+ * Number of runs of the search stopped by their cutoff and restarted (see VF2ppOptions::restart_base).
+ */
+typedef struct {
+    long num_states;
+    long heap_calls;
+    long nogood_lookups;
+    long nogood_hits;
+    int value_order;
+    long first_choices;
+    long endgames;
+    long fallbacks;
+    long restarts;
+} VF2ppStats;
+
+/**
+ * @struct FrontierLevel
+ * @brief This structure records how the frontier changed when the pair of a depth was mapped, so that the change can be undone.
+ *
+ * @var FrontierLevel::trail1_start
+ * Size of `Frontier::trail1` before the pair was mapped.
+ * @var FrontierLevel::trail2_start
+ * Size of `Frontier::trail2` before the pair was mapped.
+ * @var FrontierLevel::in_T1
+ * True if the node of `G1` was in T1 (and not in T1_tilde) before being mapped.
+ * @var FrontierLevel::in_T2
+ * True if the node of `G2` was in T2 (and not in T2_tilde) before being mapped.
+ */
+typedef struct {
+    int trail1_start;
+    int trail2_start;
+    bool in_T1;
+    bool in_T2;
+} FrontierLevel;
+
+/**
+ * @struct Frontier
+ * @brief This structure contains the frontier of the current partial mapping, stored as bitsets.
+ *
+ * T1 (T2) is the set of unmapped nodes of G1 (G2) with at least one mapped neighbor, T1_tilde (T2_tilde) the set of unmapped nodes with none.
+ * Mapping a node adds its unmapped neighbors to T with a word-wide OR/ANDNOT of its adjacency bitset; the nodes added are pushed
+ * on a trail, so that unmapping it only moves them back to T_tilde. The size of a set is the popcount of its bitset (bitset_count).
+ * When the graphs are too large for the adjacency bitsets, the neighbor lists are scanned instead.
+ *
+ * @var Frontier::words
+ * Number of words of each bitset.
+ * @var Frontier::adjacency1
+ * Adjacency bitsets of `G1`, owned by the graph; NULL when the neighbor lists are used.
+ * @var Frontier::adjacency2
+ * Adjacency bitsets of `G2`, owned by the graph; NULL when the neighbor lists are used.
+ * @var Frontier::mapped1
+ * Mapped nodes of `G1`.
+ * @var Frontier::mapped2
+ * Mapped nodes of `G2`.
+ * @var Frontier::T1
+ * Unmapped nodes of `G1` with at least one mapped neighbor.
+ * @var Frontier::T2
+ * Unmapped nodes of `G2` with at least one mapped neighbor.
+ * @var Frontier::T1_tilde
+ * Unmapped nodes of `G1` without mapped neighbors.
+ * @var Frontier::T2_tilde
+ * Unmapped nodes of `G2` without mapped neighbors.
+ * @var Frontier::trail1
+ * Nodes of `G1` added to T1, in the order of the mapping; each node is added at most once, so it has `G1->num_nodes` elements.
+ * @var Frontier::trail2
+ * Nodes of `G2` added to T2, in the order of the mapping.
+ * @var Frontier::trail1_size
+ * Number of nodes in `trail1`.
+ * @var Frontier::trail2_size
+ * Number of nodes in `trail2`.
+ * @var Frontier::levels
+ * Changes made by the pair mapped at each depth.
+ * @var Frontier::depth
+ * Number of pairs currently mapped.
+ */
+typedef struct {
+    int words;
+    const uint64_t* adjacency1;
+    const uint64_t* adjacency2;
+    uint64_t* mapped1;
+    uint64_t* mapped2;
+    uint64_t* T1;
+    uint64_t* T2;
+    uint64_t* T1_tilde;
+    uint64_t* T2_tilde;
+    int* trail1;
+    int* trail2;
+    int trail1_size;
+    int trail2_size;
+    FrontierLevel* levels;
+    int depth;
+} Frontier;
+
+/**
+ * @struct VF2ppState
+ * @brief This structure contains the whole state of a VF2++ search, so that the search can be suspended when a mapping is found and resumed later.
+ *
+ * @var VF2ppState::G1
+ * Pointer to the G1 graph searched: the one given to `vf2pp_init`, or its complement when `complemented` is true.
+ * @var VF2ppState::G2
+ * Pointer to the G2 graph searched: the one given to `vf2pp_init`, or its complement when `complemented` is true.
+ * @var VF2ppState::input1
+ * Pointer to the G1 graph given to `vf2pp_init`.
+ * @var VF2ppState::input2
+ * Pointer to the G2 graph given to `vf2pp_init`.
+ * @var VF2ppState::complemented
+ * True when the graphs are dense and the search runs on their complements, owned by the state (see `COMPLEMENT_MIN_DENSITY`).
+ * @var VF2ppState::frontier
+ * Frontier of the current partial mapping (T1, T2, T1_tilde, T2_tilde).
+ * @var VF2ppState::filter
+ * Bitsets used to find the candidates of nodes with several mapped neighbors.
+ * @var VF2ppState::use_filter
+ * True if `filter` has been built (G2 is small enough for its adjacency bitsets); the frontier then uses the adjacency bitsets too.
+ * @var VF2ppState::node_order
+ * Order in which the nodes of `G1` are matched.
+ * @var VF2ppState::stack
+ * Stack of the nodes of `G1` currently in the mapping, with the position of the scan of their candidates; its capacity is the number of nodes, so it never grows.
+ * @var VF2ppState::matching_node
+ * Index in `node_order` of the next node to be matched.
+ * @var VF2ppState::num_mapping
+ * Number of nodes currently mapped.
+ * @var VF2ppState::pending
+ * True when the last node of `node_order` is mapped because a mapping has just been returned.
+ * @var VF2ppState::options
+ * Optional features of the search.
+ * @var VF2ppState::stats
+ * Statistics of the search so far.
+ * @var VF2ppState::budget_exceeded
+ * True when the search has been stopped because `options.max_states` states have been explored.
+ * @var VF2ppState::symmetry
+ * Symmetry data of G1, NULL when symmetry breaking is disabled.
+ * @var VF2ppState::forbidden
+ * Pairs excluded by symmetry breaking.
+ * @var VF2ppState::orbit
+ * Buffer of `G1->num_nodes` elements used to compute the orbits.
+ * @var VF2ppState::visited
+ * Buffer of `G1->num_nodes` booleans used to compute the orbits.
+ * @var VF2ppState::backjumping
+ * True when the search keeps the conflict sets and backjumps; it needs the adjacency bitsets of the frontier and of `filter`.
+ * @var VF2ppState::conflicts
+ * Conflict set of each depth.
+ * @var VF2ppState::use_nogoods
+ * True when the failed subproblems are recorded (`options.nogoods`).
+ * @var VF2ppState::nogoods
+ * Table of the failed subproblems and fingerprint of the partial mapping at each depth.
+ * @var VF2ppState::use_domains
+ * True when the domains are kept (`options.forward_checking` or `options.dynamic_order`); the candidates of a depth are then
+ * scanned in the domain of its node, with the cursor of the stack element as the next node of G2 to check.
+ * @var VF2ppState::domains
+ * Domains of the nodes of G1, used when `use_domains` is true.
+ * @var VF2ppState::dynamic
+ * True when the next node is chosen dynamically (`options.dynamic_order`).
+ * @var VF2ppState::order
+ * Keys of the nodes of G1 and their tree, used when `dynamic` is true.
+ * @var VF2ppState::use_all_different
+ * True when the all-different propagator runs (`options.all_different_period`).
+ * @var VF2ppState::all_different
+ * Matching between T1 and T2 kept by the propagator, used when `use_all_different` is true.
+ * @var VF2ppState::use_value_order
+ * True when the candidates are tried by rank (`options.value_order` other than VALUE_ORDER_SCAN).
+ * @var VF2ppState::ranks
+ * Data of the strategy that ranks the candidates, used when `use_value_order` is true.
+ * @var VF2ppState::use_endgame
+ * True when the last unmapped nodes are matched by the endgame (`options.endgame_threshold`).
+ * @var VF2ppState::endgame
+ * Buffers of the endgame, used when `use_endgame` is true.
+ * @var VF2ppState::finished
+ * True once the endgame has completed a mapping: the search cannot be resumed, and the next call of `vf2pp_next` returns false.
+ */
+typedef struct {
+    Graph* G1;
+    Graph* G2;
+    Graph* input1;
+    Graph* input2;
+    bool complemented;
+    Frontier frontier;
+    CandidateFilter filter;
+    bool use_filter;
+    int* node_order;
+    Stack stack;
+    int matching_node;
+    int num_mapping;
+    bool pending;
+    VF2ppOptions options;
+    VF2ppStats stats;
+    bool budget_exceeded;
+    Symmetry* symmetry;
+    ForbiddenPairs forbidden;
+    int* orbit;
+    bool* visited;
+    bool backjumping;
+    ConflictSets conflicts;
+    bool use_nogoods;
+    Nogoods nogoods;
+    bool use_domains;
+    Domains domains;
+    bool dynamic;
+    DynamicOrder order;
+    bool use_all_different;
+    AllDifferent all_different;
+    bool use_value_order;
+    ValueRanks ranks;
+    bool use_endgame;
+    Endgame endgame;
+    bool finished;
+} VF2ppState;
 
 /**
  * @brief This function checks whether two graphs are isomorphic.
@@ -50,21 +377,119 @@
 bool vf2pp_is_isomorphic(Graph* G1, Graph* G2);
 
 /**
- * @brief This function checks whether two graphs are isomorphic.
+ * @brief This function checks whether two graphs are isomorphic, using the optional features in `options`.
  * 
+ * When G1 is a forest, the graphs are compared by their AHU canonical labels, without any search (see forest.h); otherwise,
+ * when G1 is disconnected, its connected components are matched independently to those of G2 (see components.h), when
+ * nodes of degree 1 hang from it, the search runs only on the 2-cores (see core.h), and when it has twins, only on the quotient
+ * graphs (see twins.h). Graphs of at most SMALL_SEARCH_MAX_NODES nodes are searched by an engine that keeps every set of nodes
+ * in one or two words (see small_search.h), unless an option that it does not implement is set. With `fallback_states`, a search
+ * of the whole graphs that stalls is abandoned for the canonical certificates of the graphs (see canonical.h).
+ * The enumeration of the mappings (vf2pp_init and vf2pp_next) always searches the whole graphs.
+ * 
+ * @param G1 Pointer to G1 graph.
  * @param G2 Pointer to G2 graph.
- * @param popped_node2 The node removed from the mapping.
- * @param T2_tilde Boolean array indicating which nodes in `G2` are unmapped and are not neighbors of mapped nodes.
+ * @param options Pointer to the options of the search, NULL for the default ones.
+ * @param stats Pointer filled with the statistics of the search, NULL if they are not needed.
+ * @return A boolean value indicating whether G1 and G2 are isomorphic.
  */
-void _restore_Tinout(Graph* G2, int popped_node2, bool* T2_tilde);
+bool vf2pp_is_isomorphic_with_options(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats);
 
 /**
- * @brief This function checks whether two graphs are isomorphic.
+ * @brief This function sets the default options: every optional feature disabled and no limit on the states.
+ * 
+ * @param options Pointer to the options to be initialized.
+ */
+void vf2pp_default_options(VF2ppOptions* options);
+
+/**
+ * @brief This function sets the statistics of a search that explored no state: the heap calls are -1 without the heap counter.
+ * 
+ * @param stats Pointer to the statistics to be initialized.
+ */
+void vf2pp_clear_stats(VF2ppStats* stats);
+
+/**
+ * @brief This function prepares a resumable VF2++ search between two graphs.
+ * 
+ * Two graphs are isomorphic exactly when their complements are, with the same mappings: when the graphs are denser than
+ * `COMPLEMENT_MIN_DENSITY` the search runs on their complements, which have fewer edges, and the mappings are reported unchanged.
+ * The node signatures cached with both graphs (see signature.h) are always used as keys: a node is only mapped to a node with the
+ * same signature.
  * 
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param options Pointer to the options of the search, NULL for the default ones.
+ * @return Pointer to the search state, or NULL if the graphs cannot be isomorphic or memory cannot be allocated.
+ */
+VF2ppState* vf2pp_init(Graph* G1, Graph* G2, const VF2ppOptions* options);
+
+/**
+ * @brief This function resumes the search and stops at the next mapping found.
+ * 
+ * @param state Pointer to the search state.
+ * @param mapping Array of `G1->num_nodes` elements filled with the image in `G2` of each node of `G1`. It can be NULL when the mapping is not needed.
+ * @return True if a new mapping has been found, false if the search is over.
+ */
+bool vf2pp_next(VF2ppState* state, int* mapping);
+
+/**
+ * @brief Frees up the memory allocated for the search state.
+ * 
+ * @param state Pointer to the search state to be freed.
+ */
+void vf2pp_free(VF2ppState* state);
+
+/**
+ * @brief This function allocates the frontier of an empty mapping: every node in T1_tilde/T2_tilde.
+ * 
+ * @param frontier Pointer to the frontier to be initialized.
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph, with the same number of nodes as `G1`.
+ * @param use_adjacency True to update the frontier with the adjacency bitsets of the graphs, false to scan the neighbor lists.
+ * @return True on success, false if memory cannot be allocated.
+ */
+bool init_frontier(Frontier* frontier, Graph* G1, Graph* G2, bool use_adjacency);
+
+/**
+ * @brief Frees up the memory allocated for the frontier; the adjacency bitsets stay with the graphs.
+ * 
+ * @param frontier Pointer to the frontier to be freed.
+ */
+void free_frontier(Frontier* frontier);
+
+/**
+ * @brief This function updates the frontier when a pair is removed from the mapping; the pairs must be removed in the reverse order of insertion.
+ * 
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param popped_node1 The node of `G1` removed from the mapping, the last one added.
+ * @param popped_node2 The node of `G2` removed from the mapping, the last one added.
+ * @param frontier Pointer to the frontier.
+ */
+void _restore_Tinout(Graph* G1, Graph* G2, int popped_node1, int popped_node2, Frontier* frontier);
+
+/**
+ * @brief This function updates the frontier when a pair is added to the mapping.
+ * 
+ * @param G1 Pointer to G1 graph.
+ * @param G2 Pointer to G2 graph.
+ * @param new_node1 The node of `G1` added to the mapping, already mapped.
+ * @param new_node2 The node of `G2` added to the mapping, already mapped.
+ * @param frontier Pointer to the frontier.
+ */
+void _update_Tinout(Graph* G1, Graph* G2, int new_node1, int new_node2, Frontier* frontier);
+
+/**
+ * @brief This function applies the VF2++ consistency check and cut rules to a candidate pair.
+ * 
+ * @param G1 Pointer to G1 graph.
  * @param G2 Pointer to G2 graph.
- * @param new_node2 The node added to the mapping.
- * @param T2_tilde Boolean array indicating which nodes in `G2` are unmapped and are not neighbors of mapped nodes.
+ * @param u Node of `G1`, not mapped.
+ * @param v Candidate node of `G2`, not mapped.
+ * @param frontier Pointer to the frontier of the current mapping.
+ * @return True if the pair (u, v) cannot extend the current mapping.
  */
-void _update_Tinout(Graph* G2, int new_node2, bool* T2_tilde);
+bool _cut_PT(Graph* G1, Graph* G2, int u, int v, Frontier* frontier);
 
 #endif // VF2PP_H
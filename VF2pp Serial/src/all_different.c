@@ -0,0 +1,278 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file all_different.c
+ * @brief This file contains the functions that repair the matching between T1 and T2 and filter the domains with it.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - bitset.h: Definition of the bitsets of the frontier and of the domains.
+ * - domains.h: Defines the domains whose candidates are matched.
+ * - all_different.h: Defines the matching and its buffers.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitset.h"
+#include "domains.h"
+#include "all_different.h"
+
+/**
+ * Allocates every array of the structure; no node is matched.
+ */
+bool init_all_different(AllDifferent* all_different, int num_nodes, int words, int period) {
+    memset(all_different, 0, sizeof(AllDifferent));
+    all_different->num_nodes = num_nodes;
+    all_different->words = words;
+    all_different->period = period;
+    all_different->pruned_depth = (int*)malloc(num_nodes * sizeof(int));
+    all_different->mate1 = (int*)malloc(num_nodes * sizeof(int));
+    all_different->mate2 = (int*)malloc(num_nodes * sizeof(int));
+    all_different->visited = (uint64_t*)malloc(words * sizeof(uint64_t));
+    all_different->frame_node = (int*)malloc(num_nodes * sizeof(int));
+    all_different->frame_via = (int*)malloc(num_nodes * sizeof(int));
+    all_different->frame_cursor = (int*)malloc(num_nodes * sizeof(int));
+    all_different->index = (int*)malloc(num_nodes * sizeof(int));
+    all_different->low = (int*)malloc(num_nodes * sizeof(int));
+    all_different->component = (int*)malloc(num_nodes * sizeof(int));
+    all_different->open = (int*)malloc(num_nodes * sizeof(int));
+    if (all_different->pruned_depth == NULL || all_different->mate1 == NULL || all_different->mate2 == NULL || all_different->visited == NULL
+        || all_different->frame_node == NULL || all_different->frame_via == NULL || all_different->frame_cursor == NULL
+        || all_different->index == NULL || all_different->low == NULL || all_different->component == NULL
+        || all_different->open == NULL) {
+        free_all_different(all_different);
+        return false;
+    }
+    for (int i = 0; i < num_nodes; i++) {
+        all_different->mate1[i] = -1;
+        all_different->mate2[i] = -1;
+    }
+    return true;
+}
+
+/**
+ * Frees every array of the structure.
+ */
+void free_all_different(AllDifferent* all_different) {
+    free(all_different->pruned_depth);
+    free(all_different->mate1);
+    free(all_different->mate2);
+    free(all_different->visited);
+    free(all_different->frame_node);
+    free(all_different->frame_via);
+    free(all_different->frame_cursor);
+    free(all_different->index);
+    free(all_different->low);
+    free(all_different->component);
+    free(all_different->open);
+    memset(all_different, 0, sizeof(AllDifferent));
+}
+
+/**
+ * Returns the first candidate of u (domain AND T2) not below `from` and not yet visited, -1 if there is none.
+ */
+static int _next_unvisited(const AllDifferent* all_different, const Domains* domains, int u, const uint64_t* T2, int from) {
+    if (from >= domains->num_nodes) {
+        return -1;
+    }
+    const uint64_t* domain = domains->bits + (size_t)u * domains->words;
+    const uint64_t* visited = all_different->visited;
+    int i = from / BITSET_WORD_BITS;
+    uint64_t word = domain[i] & T2[i] & ~visited[i] & (~0ULL << (from % BITSET_WORD_BITS));
+    while (word == 0) {
+        if (++i == domains->words) {
+            return -1;
+        }
+        word = domain[i] & T2[i] & ~visited[i];
+    }
+    return i * BITSET_WORD_BITS + bitset_lowest_bit(word);
+}
+
+/**
+ * Looks for an augmenting path from the free node s with an iterative depth-first search: each frame tries the candidates of its
+ * node not yet visited; a free candidate ends the path, whose pairs are then swapped, a matched one opens a frame for its match.
+ * Every candidate is visited once, so the search is linear in the candidates of the nodes reached.
+ */
+static bool _augment(AllDifferent* all_different, const Domains* domains, const uint64_t* T2, int s) {
+    memset(all_different->visited, 0, all_different->words * sizeof(uint64_t));
+    int top = 0;
+    all_different->frame_node[0] = s;
+    all_different->frame_cursor[0] = 0;
+    while (top >= 0) {
+        int u = all_different->frame_node[top];
+        int v = _next_unvisited(all_different, domains, u, T2, all_different->frame_cursor[top]);
+        if (v == -1) {
+            top--;
+            continue;
+        }
+        all_different->frame_cursor[top] = v + 1;
+        all_different->frame_via[top] = v;
+        bitset_set(all_different->visited, v);
+        if (all_different->mate2[v] == -1) {
+            for (int i = 0; i <= top; i++) {
+                all_different->mate1[all_different->frame_node[i]] = all_different->frame_via[i];
+                all_different->mate2[all_different->frame_via[i]] = all_different->frame_node[i];
+            }
+            return true;
+        }
+        top++;
+        all_different->frame_node[top] = all_different->mate2[v];
+        all_different->frame_cursor[top] = 0;
+    }
+    return false;
+}
+
+/**
+ * Finds the strongly connected components of the graph that links every node u of T1 to the nodes matched to its candidates
+ * other than its match (Tarjan, with an explicit stack of frames). Returns the number of components.
+ */
+static int _components(AllDifferent* all_different, const Domains* domains, const uint64_t* T1, const uint64_t* T2) {
+    int* index = all_different->index;
+    int* low = all_different->low;
+    int* component = all_different->component;
+    int counter = 0, components = 0, num_open = 0;
+    for (int i = 0; i < all_different->words; i++) {
+        for (uint64_t word = T1[i]; word != 0; word &= word - 1) {
+            index[i * BITSET_WORD_BITS + bitset_lowest_bit(word)] = -1;
+        }
+    }
+    for (int i = 0; i < all_different->words; i++) {
+        for (uint64_t word = T1[i]; word != 0; word &= word - 1) {
+            int s = i * BITSET_WORD_BITS + bitset_lowest_bit(word);
+            if (index[s] != -1) {
+                continue;
+            }
+            int top = 0;
+            all_different->frame_node[0] = s;
+            all_different->frame_cursor[0] = 0;
+            index[s] = low[s] = counter++;
+            component[s] = -1;
+            all_different->open[num_open++] = s;
+            while (top >= 0) {
+                int u = all_different->frame_node[top];
+                int v = next_domain_candidate(domains, u, T2, all_different->frame_cursor[top]);
+                if (v != -1) {
+                    all_different->frame_cursor[top] = v + 1;
+                    int w = all_different->mate2[v];
+                    if (v == all_different->mate1[u]) {
+                        continue;
+                    }
+                    if (index[w] == -1) {
+                        top++;
+                        all_different->frame_node[top] = w;
+                        all_different->frame_cursor[top] = 0;
+                        index[w] = low[w] = counter++;
+                        component[w] = -1;
+                        all_different->open[num_open++] = w;
+                    } else if (component[w] == -1 && index[w] < low[u]) {
+                        low[u] = index[w];
+                    }
+                    continue;
+                }
+                top--;
+                if (low[u] == index[u]) {
+                    int w;
+                    do {
+                        w = all_different->open[--num_open];
+                        component[w] = components;
+                    } while (w != u);
+                    components++;
+                }
+                if (top >= 0 && low[u] < low[all_different->frame_node[top]]) {
+                    low[all_different->frame_node[top]] = low[u];
+                }
+            }
+        }
+    }
+    return components;
+}
+
+/**
+ * 1. Drops the pairs no longer valid: the node of G1 has left T1 or the node of G2 is no longer one of its candidates.
+ * 2. Matches every free node of T1 with an augmenting path (_augment); if one has none, no matching covers T1.
+ * 3. When the matching covers T2 too (T1 and T2 have the same size in every consistent state), finds the components
+ *    (_components) and, when there are several, removes every candidate of a node of T1 that is not its match and whose match is
+ *    in another component.
+ * Returns the number of candidates removed, -1 if no matching covers T1.
+ */
+static int _propagate(AllDifferent* all_different, Domains* domains, const uint64_t* T1, const uint64_t* T2) {
+    int* mate1 = all_different->mate1;
+    int* mate2 = all_different->mate2;
+    int words = all_different->words;
+    for (int u = 0; u < all_different->num_nodes; u++) {
+        int v = mate1[u];
+        if (v != -1 && !(bitset_test(T1, u) && bitset_test(T2, v) && bitset_test(domains->bits + (size_t)u * words, v))) {
+            mate1[u] = -1;
+            mate2[v] = -1;
+        }
+    }
+    int matched = 0;
+    for (int i = 0; i < words; i++) {
+        for (uint64_t word = T1[i]; word != 0; word &= word - 1) {
+            int u = i * BITSET_WORD_BITS + bitset_lowest_bit(word);
+            if (mate1[u] == -1 && !_augment(all_different, domains, T2, u)) {
+                return -1;
+            }
+            matched++;
+        }
+    }
+    if (matched != bitset_count(T2, words) || _components(all_different, domains, T1, T2) < 2) {
+        return 0;
+    }
+    const int* component = all_different->component;
+    int removed = 0;
+    for (int i = 0; i < words; i++) {
+        for (uint64_t word = T1[i]; word != 0; word &= word - 1) {
+            int u = i * BITSET_WORD_BITS + bitset_lowest_bit(word);
+            for (int v = next_domain_candidate(domains, u, T2, 0); v != -1; v = next_domain_candidate(domains, u, T2, v + 1)) {
+                if (v != mate1[u] && component[mate2[v]] != component[u]) {
+                    if (!remove_domain_value(domains, u, v)) {
+                        return removed;
+                    }
+                    removed++;
+                }
+            }
+        }
+    }
+    return removed;
+}
+
+/**
+ * Runs the propagator (_propagate) at the selected depths, then records whether the depth removed candidates.
+ */
+bool propagate_all_different(AllDifferent* all_different, Domains* domains, const uint64_t* T1, const uint64_t* T2, int depth) {
+    int removed = 0;
+    if ((depth + 1) % all_different->period == 0) {
+        removed = _propagate(all_different, domains, T1, T2);
+        if (removed == -1) {
+            return false;
+        }
+    }
+    all_different->pruned_depth[depth] = (removed > 0) ? depth : pruned_below(all_different, depth);
+    return true;
+}
@@ -0,0 +1,299 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file bitset.c
+ * @brief This file contains the kernels that operate on bitsets, with AVX-512 and AVX2 versions selected at run time and a portable fallback.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - bitset.h: Definition of the bitsets and of their kernels.
+ * - graph.h: Definition of graph structure.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "bitset.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define BITSET_X86_KERNELS 1
+#endif
+
+/**
+ * Portable kernels, working on one word at a time.
+ */
+static bool and_portable(uint64_t* dst, const uint64_t* src, int words) {
+    uint64_t any = 0;
+    for (int i = 0; i < words; i++) {
+        dst[i] &= src[i];
+        any |= dst[i];
+    }
+    return any != 0;
+}
+
+static bool and3_portable(uint64_t* dst, const uint64_t* a, const uint64_t* b, int words) {
+    uint64_t any = 0;
+    for (int i = 0; i < words; i++) {
+        dst[i] = a[i] & b[i];
+        any |= dst[i];
+    }
+    return any != 0;
+}
+
+static int and_count_portable(const uint64_t* a, const uint64_t* b, int words) {
+    int count = 0;
+    for (int i = 0; i < words; i++) {
+#ifdef __GNUC__
+        count += __builtin_popcountll(a[i] & b[i]);
+#else
+        for (uint64_t w = a[i] & b[i]; w != 0; w &= w - 1) {
+            count++;
+        }
+#endif
+    }
+    return count;
+}
+
+#ifdef BITSET_X86_KERNELS
+/**
+ * Population count with the POPCNT instruction, instead of the software routine used when the target CPU is not known.
+ */
+__attribute__((target("popcnt")))
+static int and_count_popcnt(const uint64_t* a, const uint64_t* b, int words) {
+    int count = 0;
+    for (int i = 0; i < words; i++) {
+        count += __builtin_popcountll(a[i] & b[i]);
+    }
+    return count;
+}
+
+/**
+ * AVX2 kernels: 4 words per iteration, the remaining words are handled one at a time.
+ */
+__attribute__((target("avx2")))
+static bool and_avx2(uint64_t* dst, const uint64_t* src, int words) {
+    __m256i any = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= words; i += 4) {
+        __m256i r = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(dst + i)), _mm256_loadu_si256((const __m256i*)(src + i)));
+        _mm256_storeu_si256((__m256i*)(dst + i), r);
+        any = _mm256_or_si256(any, r);
+    }
+    uint64_t rest = 0;
+    for (; i < words; i++) {
+        dst[i] &= src[i];
+        rest |= dst[i];
+    }
+    return !_mm256_testz_si256(any, any) || rest != 0;
+}
+
+__attribute__((target("avx2")))
+static bool and3_avx2(uint64_t* dst, const uint64_t* a, const uint64_t* b, int words) {
+    __m256i any = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= words; i += 4) {
+        __m256i r = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i)));
+        _mm256_storeu_si256((__m256i*)(dst + i), r);
+        any = _mm256_or_si256(any, r);
+    }
+    uint64_t rest = 0;
+    for (; i < words; i++) {
+        dst[i] = a[i] & b[i];
+        rest |= dst[i];
+    }
+    return !_mm256_testz_si256(any, any) || rest != 0;
+}
+
+/**
+ * AVX-512 kernels: 8 words per iteration, the remaining words are handled with a masked load and store.
+ */
+__attribute__((target("avx512f")))
+static bool and_avx512(uint64_t* dst, const uint64_t* src, int words) {
+    __m512i any = _mm512_setzero_si512();
+    int i = 0;
+    for (; i + 8 <= words; i += 8) {
+        __m512i r = _mm512_and_si512(_mm512_loadu_si512((const void*)(dst + i)), _mm512_loadu_si512((const void*)(src + i)));
+        _mm512_storeu_si512((void*)(dst + i), r);
+        any = _mm512_or_si512(any, r);
+    }
+    if (i < words) {
+        __mmask8 mask = (__mmask8)((1u << (words - i)) - 1);
+        __m512i r = _mm512_and_si512(_mm512_maskz_loadu_epi64(mask, dst + i), _mm512_maskz_loadu_epi64(mask, src + i));
+        _mm512_mask_storeu_epi64(dst + i, mask, r);
+        any = _mm512_or_si512(any, r);
+    }
+    return _mm512_test_epi64_mask(any, any) != 0;
+}
+
+__attribute__((target("avx512f")))
+static bool and3_avx512(uint64_t* dst, const uint64_t* a, const uint64_t* b, int words) {
+    __m512i any = _mm512_setzero_si512();
+    int i = 0;
+    for (; i + 8 <= words; i += 8) {
+        __m512i r = _mm512_and_si512(_mm512_loadu_si512((const void*)(a + i)), _mm512_loadu_si512((const void*)(b + i)));
+        _mm512_storeu_si512((void*)(dst + i), r);
+        any = _mm512_or_si512(any, r);
+    }
+    if (i < words) {
+        __mmask8 mask = (__mmask8)((1u << (words - i)) - 1);
+        __m512i r = _mm512_and_si512(_mm512_maskz_loadu_epi64(mask, a + i), _mm512_maskz_loadu_epi64(mask, b + i));
+        _mm512_mask_storeu_epi64(dst + i, mask, r);
+        any = _mm512_or_si512(any, r);
+    }
+    return _mm512_test_epi64_mask(any, any) != 0;
+}
+#endif
+
+/**
+ * Kernels selected for the current CPU, the first time a kernel is used.
+ */
+typedef struct {
+    bool (*and_kernel)(uint64_t*, const uint64_t*, int);
+    bool (*and3_kernel)(uint64_t*, const uint64_t*, const uint64_t*, int);
+    int (*and_count_kernel)(const uint64_t*, const uint64_t*, int);
+    const char* name;
+} BitsetKernels;
+
+static BitsetKernels kernels = { NULL, NULL, NULL, NULL };
+
+static void select_kernels(void) {
+    BitsetKernels selected = { and_portable, and3_portable, and_count_portable, "portable" };
+#ifdef BITSET_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("popcnt")) {
+        selected.and_count_kernel = and_count_popcnt;
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        selected.and_kernel = and_avx512;
+        selected.and3_kernel = and3_avx512;
+        selected.name = "avx512";
+    } else if (__builtin_cpu_supports("avx2")) {
+        selected.and_kernel = and_avx2;
+        selected.and3_kernel = and3_avx2;
+        selected.name = "avx2";
+    }
+#endif
+    kernels = selected;
+}
+
+void bitset_init_kernels(void) {
+    if (kernels.name == NULL) {
+        select_kernels();
+    }
+}
+
+/**
+ * Allocates the words of the bitset, all zero.
+ */
+uint64_t* bitset_alloc(int num_bits) {
+    int words = bitset_words(num_bits);
+    return (uint64_t*)calloc(words > 0 ? words : 1, sizeof(uint64_t));
+}
+
+bool bitset_and(uint64_t* dst, const uint64_t* src, int words) {
+    if (kernels.and_kernel == NULL) {
+        select_kernels();
+    }
+    return kernels.and_kernel(dst, src, words);
+}
+
+bool bitset_and3(uint64_t* dst, const uint64_t* a, const uint64_t* b, int words) {
+    if (kernels.and3_kernel == NULL) {
+        select_kernels();
+    }
+    return kernels.and3_kernel(dst, a, b, words);
+}
+
+/**
+ * Counts the bits with the population count of each word.
+ */
+int bitset_count(const uint64_t* bits, int words) {
+    int count = 0;
+    for (int i = 0; i < words; i++) {
+#ifdef __GNUC__
+        count += __builtin_popcountll(bits[i]);
+#else
+        for (uint64_t w = bits[i]; w != 0; w &= w - 1) {
+            count++;
+        }
+#endif
+    }
+    return count;
+}
+
+int bitset_and_count(const uint64_t* a, const uint64_t* b, int words) {
+    if (kernels.and_count_kernel == NULL) {
+        select_kernels();
+    }
+    return kernels.and_count_kernel(a, b, words);
+}
+
+/**
+ * Bit-scan loop: for each non-zero word, takes the lowest bit set and clears it until the word is empty.
+ */
+int bitset_to_array(const uint64_t* bits, int words, int* out) {
+    int size = 0;
+    for (int i = 0; i < words; i++) {
+        uint64_t w = bits[i];
+        while (w != 0) {
+            out[size++] = i * BITSET_WORD_BITS + bitset_lowest_bit(w);
+            w &= w - 1;
+        }
+    }
+    return size;
+}
+
+const char* bitset_kernel_name(void) {
+    if (kernels.name == NULL) {
+        select_kernels();
+    }
+    return kernels.name;
+}
+
+/**
+ * Builds the adjacency bitsets of the graph the first time they are needed, setting the bit of every neighbor of each node.
+ */
+uint64_t* graph_adjacency(Graph* g) {
+    if (g->adjacency == NULL) {
+        int words = bitset_words(g->num_nodes);
+        uint64_t* adjacency = (uint64_t*)calloc((size_t)g->num_nodes * words + 1, sizeof(uint64_t));
+        if (adjacency == NULL) {
+            fprintf(stderr, "ERROR: adjacency bitsets allocation error");
+            return NULL;
+        }
+        for (int u = 0; u < g->num_nodes; u++) {
+            for (int i = 0; i < g->nodes[u].num_neighbors; i++) {
+                bitset_set(adjacency + (size_t)u * words, g->nodes[u].neighborhood[i]);
+            }
+        }
+        g->adjacency = adjacency;
+    }
+    return g->adjacency;
+}
@@ -0,0 +1,738 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file canonical.c
+ * @brief This file contains the functions used to compute the canonical labeling of a graph and its certificate.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - canonical.h: Definition of the certificate.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "canonical.h"
+
+/* Maximum number of automorphisms stored for each node of the graph */
+#define GENERATORS_PER_NODE 8
+
+/**
+ * Ordered partition of the nodes: every cell is a range of positions of `lab`.
+ * `cell` stores the start position of the cell of each node, `cell_end` the end position (excluded) of the cell starting at each position.
+ */
+typedef struct {
+    int* lab;
+    int* cell;
+    int* cell_end;
+    int num_cells;
+} Partition;
+
+/**
+ * Node with the key used to split its cell.
+ */
+typedef struct {
+    int key;
+    int node;
+} KeyedNode;
+
+/**
+ * State of the individualization-refinement search.
+ * - refinement buffers: neighbour counts, touched nodes and cells, queue of the splitting cells;
+ * - search tree: one partition and one trace (hash of the refinement) for each depth, and the individualized nodes of the current path;
+ * - leaves: code of the current leaf and the first and best leaves found, the best being the one with the greatest (trace, code);
+ * - automorphisms: the permutations found by comparing leaves with equal codes, with the nodes they move, and a union-find structure for the orbits.
+ */
+typedef struct {
+    Graph* g;
+    const int* colors;
+    int n;
+
+    int* count;
+    int* touched;
+    int* touched_cells;
+    bool* cell_marked;
+    int* queue;
+    int queue_head;
+    int queue_size;
+    bool* in_queue;
+    KeyedNode* keys;
+
+    Partition* levels;
+    unsigned long long* trace;
+    bool* in_path;
+
+    int* inv;
+    int* row;
+    int* code;
+    int code_size;
+    bool has_best;
+    int best_depth;
+    unsigned long long* best_trace;
+    int* best_lab;
+    int* best_code;
+    int first_depth;
+    unsigned long long* first_trace;
+    int* first_lab;
+    int* first_code;
+    long num_leaves;
+
+    int** generators;
+    int** support;
+    int* support_size;
+    int num_generators;
+    int* parent;
+} CanonicalSearch;
+
+/**
+ * Comparison function used by qsort to sort integers in ascending order.
+ */
+static int compare_int(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Comparison function used by qsort to sort the nodes of a cell by key.
+ */
+static int compare_keyed_node(const void* a, const void* b) {
+    const KeyedNode* x = (const KeyedNode*)a;
+    const KeyedNode* y = (const KeyedNode*)b;
+    if (x->key != y->key) {
+        return (x->key > y->key) - (x->key < y->key);
+    }
+    return (x->node > y->node) - (x->node < y->node);
+}
+
+/**
+ * Adds a value to a hash (FNV-1a on the 32 bits of the value).
+ */
+static unsigned long long mix(unsigned long long h, int value) {
+    h ^= (unsigned long long)(unsigned int)value;
+    return h * 1099511628211ULL;
+}
+
+/**
+ * Finds the representative of the set containing `x`, compressing the path.
+ */
+static int find_root(int* parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/**
+ * Adds the cell starting at `start` to the queue of the splitting cells.
+ */
+static void enqueue_cell(CanonicalSearch* s, int start) {
+    if (s->in_queue[start]) {
+        return;
+    }
+    s->queue[(s->queue_head + s->queue_size) % s->n] = start;
+    s->queue_size++;
+    s->in_queue[start] = true;
+}
+
+/**
+ * Refines the partition until it is equitable: every node of a cell has the same number of neighbours in every cell.
+ * 1. Pops a splitting cell and counts, for every node, its neighbours in the splitting cell.
+ * 2. Splits every touched cell (in order of position) by count, the subcells being sorted by ascending count.
+ * 3. Queues the new subcells: all of them if the cell was already queued, all but the largest one otherwise.
+ * Every choice depends only on positions and counts, never on the node indexes, so the result and the returned trace
+ * (a hash of the splits) are invariant under relabeling of the graph.
+ */
+static unsigned long long refine(CanonicalSearch* s, Partition* p) {
+    Graph* g = s->g;
+    int n = s->n;
+    unsigned long long h = 1469598103934665603ULL;
+
+    while (s->queue_size > 0 && p->num_cells < n) {
+        int sp = s->queue[s->queue_head];
+        s->queue_head = (s->queue_head + 1) % n;
+        s->queue_size--;
+        s->in_queue[sp] = false;
+        int se = p->cell_end[sp];
+        h = mix(h, sp);
+
+        int num_touched = 0;
+        for (int i = sp; i < se; i++) {
+            Node* v = &g->nodes[p->lab[i]];
+            for (int j = 0; j < v->num_neighbors; j++) {
+                int w = v->neighborhood[j];
+                if (s->count[w]++ == 0) {
+                    s->touched[num_touched++] = w;
+                }
+            }
+        }
+        int num_cells_touched = 0;
+        for (int i = 0; i < num_touched; i++) {
+            int c = p->cell[s->touched[i]];
+            if (!s->cell_marked[c]) {
+                s->cell_marked[c] = true;
+                s->touched_cells[num_cells_touched++] = c;
+            }
+        }
+        qsort(s->touched_cells, num_cells_touched, sizeof(int), compare_int);
+
+        for (int t = 0; t < num_cells_touched; t++) {
+            int c = s->touched_cells[t];
+            int e = p->cell_end[c];
+            int size = e - c;
+            s->cell_marked[c] = false;
+
+            bool uniform = true;
+            for (int i = 0; i < size; i++) {
+                s->keys[i].key = s->count[p->lab[c + i]];
+                s->keys[i].node = p->lab[c + i];
+                uniform = uniform && s->keys[i].key == s->keys[0].key;
+            }
+            h = mix(h, c);
+            if (uniform) {
+                h = mix(h, s->keys[0].key);
+                continue;
+            }
+            qsort(s->keys, size, sizeof(KeyedNode), compare_keyed_node);
+
+            bool was_queued = s->in_queue[c];
+            int largest = c;
+            int largest_size = 0;
+            for (int i = 0; i < size; ) {
+                int j = i + 1;
+                while (j < size && s->keys[j].key == s->keys[i].key) {
+                    j++;
+                }
+                int start = c + i;
+                for (int k = i; k < j; k++) {
+                    p->lab[c + k] = s->keys[k].node;
+                    p->cell[s->keys[k].node] = start;
+                }
+                p->cell_end[start] = c + j;
+                if (i > 0) {
+                    p->num_cells++;
+                }
+                h = mix(mix(h, s->keys[i].key), j - i);
+                if (j - i > largest_size) {
+                    largest_size = j - i;
+                    largest = start;
+                }
+                i = j;
+            }
+            for (int start = c; start < e; start = p->cell_end[start]) {
+                if (was_queued ? start != c : start != largest) {
+                    enqueue_cell(s, start);
+                }
+            }
+        }
+
+        for (int i = 0; i < num_touched; i++) {
+            s->count[s->touched[i]] = 0;
+        }
+    }
+
+    /* The partition may become discrete before the queue is empty */
+    while (s->queue_size > 0) {
+        s->in_queue[s->queue[s->queue_head]] = false;
+        s->queue_head = (s->queue_head + 1) % n;
+        s->queue_size--;
+    }
+    return mix(h, p->num_cells);
+}
+
+/**
+ * Allocates the arrays of the partition of a depth the first time that depth is reached.
+ */
+static bool ensure_level(CanonicalSearch* s, int depth) {
+    Partition* p = &s->levels[depth];
+    if (p->lab != NULL) {
+        return true;
+    }
+    p->lab = (int*)malloc(s->n * sizeof(int));
+    p->cell = (int*)malloc(s->n * sizeof(int));
+    p->cell_end = (int*)malloc(s->n * sizeof(int));
+    return p->lab != NULL && p->cell != NULL && p->cell_end != NULL;
+}
+
+/**
+ * Splits the node `v` from its cell: `v` becomes a singleton cell placed before the rest of the cell.
+ */
+static void individualize(Partition* p, int v) {
+    int c = p->cell[v];
+    int e = p->cell_end[c];
+    int pos = c;
+    while (p->lab[pos] != v) {
+        pos++;
+    }
+    p->lab[pos] = p->lab[c];
+    p->lab[c] = v;
+    p->cell_end[c] = c + 1;
+    p->cell_end[c + 1] = e;
+    for (int i = c + 1; i < e; i++) {
+        p->cell[p->lab[i]] = c + 1;
+    }
+    p->num_cells++;
+}
+
+/**
+ * Returns the start of the first smallest cell with more than one node, -1 if the partition is discrete.
+ */
+static int target_cell(Partition* p, int n) {
+    int target = -1;
+    int target_size = n + 1;
+    for (int c = 0; c < n; c = p->cell_end[c]) {
+        int size = p->cell_end[c] - c;
+        if (size > 1 && size < target_size) {
+            target = c;
+            target_size = size;
+        }
+    }
+    return target;
+}
+
+/**
+ * Builds the code of the discrete partition `p`: for each position, the degree of its node and the sorted positions of its neighbours,
+ * then the color of each position.
+ */
+static void leaf_code(CanonicalSearch* s, Partition* p) {
+    Graph* g = s->g;
+    int size = 0;
+    for (int i = 0; i < s->n; i++) {
+        s->inv[p->lab[i]] = i;
+    }
+    for (int i = 0; i < s->n; i++) {
+        Node* v = &g->nodes[p->lab[i]];
+        for (int j = 0; j < v->num_neighbors; j++) {
+            s->row[j] = s->inv[v->neighborhood[j]];
+        }
+        qsort(s->row, v->num_neighbors, sizeof(int), compare_int);
+        s->code[size++] = v->num_neighbors;
+        memcpy(s->code + size, s->row, v->num_neighbors * sizeof(int));
+        size += v->num_neighbors;
+    }
+    if (s->colors != NULL) {
+        for (int i = 0; i < s->n; i++) {
+            s->code[size++] = s->colors[p->lab[i]];
+        }
+    }
+}
+
+/**
+ * Compares two codes of the same graph lexicographically.
+ */
+static int compare_code(const int* a, const int* b, int size) {
+    for (int i = 0; i < size; i++) {
+        if (a[i] != b[i]) {
+            return (a[i] > b[i]) - (a[i] < b[i]);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Compares two traces lexicographically, looking only at the first `limit + 1` elements;
+ * when one of them is a prefix of the other, the longer one is the greater.
+ */
+static int compare_trace(const unsigned long long* a, int depth_a, const unsigned long long* b, int depth_b, int limit) {
+    for (int d = 0; d <= limit && d <= depth_a && d <= depth_b; d++) {
+        if (a[d] != b[d]) {
+            return (a[d] > b[d]) ? 1 : -1;
+        }
+    }
+    if (limit <= depth_a && limit <= depth_b) {
+        return 0;
+    }
+    return (depth_a > depth_b) - (depth_a < depth_b);
+}
+
+/**
+ * Stores the automorphism that maps the leaf `lab` onto the leaf `other` (the two leaves have the same code)
+ * together with the list of the nodes it moves. The identity is discarded.
+ */
+static void add_automorphism(CanonicalSearch* s, const int* lab, const int* other) {
+    if (s->num_generators == GENERATORS_PER_NODE * s->n) {
+        return;
+    }
+    int* generator = (int*)malloc(s->n * sizeof(int));
+    if (generator == NULL) {
+        return;
+    }
+    int moved = 0;
+    for (int i = 0; i < s->n; i++) {
+        generator[lab[i]] = other[i];
+        moved += lab[i] != other[i];
+    }
+    int* support = (moved > 0) ? (int*)malloc(moved * sizeof(int)) : NULL;
+    if (support == NULL) {
+        free(generator);
+        return;
+    }
+    moved = 0;
+    for (int u = 0; u < s->n; u++) {
+        if (generator[u] != u) {
+            support[moved++] = u;
+        }
+    }
+    s->generators[s->num_generators] = generator;
+    s->support[s->num_generators] = support;
+    s->support_size[s->num_generators] = moved;
+    s->num_generators++;
+}
+
+/**
+ * Copies the current leaf into the first or best leaf.
+ */
+static void store_leaf(CanonicalSearch* s, Partition* p, int depth, int* lab, int* code, unsigned long long* trace, int* stored_depth) {
+    memcpy(lab, p->lab, s->n * sizeof(int));
+    memcpy(code, s->code, s->code_size * sizeof(int));
+    memcpy(trace, s->trace, (depth + 1) * sizeof(unsigned long long));
+    *stored_depth = depth;
+}
+
+/**
+ * Compares a leaf with the first and the best leaves:
+ * - equal codes give an automorphism of the graph, used to prune the search;
+ * - a greater (trace, code) makes the leaf the new best one.
+ */
+static void process_leaf(CanonicalSearch* s, Partition* p, int depth) {
+    s->num_leaves++;
+    leaf_code(s, p);
+    if (!s->has_best) {
+        store_leaf(s, p, depth, s->first_lab, s->first_code, s->first_trace, &s->first_depth);
+        store_leaf(s, p, depth, s->best_lab, s->best_code, s->best_trace, &s->best_depth);
+        s->has_best = true;
+        return;
+    }
+
+    if (compare_trace(s->trace, depth, s->first_trace, s->first_depth, s->n) == 0 &&
+        compare_code(s->code, s->first_code, s->code_size) == 0) {
+        add_automorphism(s, p->lab, s->first_lab);
+        return;
+    }
+    int cmp = compare_trace(s->trace, depth, s->best_trace, s->best_depth, s->n);
+    if (cmp == 0) {
+        cmp = compare_code(s->code, s->best_code, s->code_size);
+    }
+    if (cmp == 0) {
+        add_automorphism(s, p->lab, s->best_lab);
+    } else if (cmp > 0) {
+        store_leaf(s, p, depth, s->best_lab, s->best_code, s->best_trace, &s->best_depth);
+    }
+}
+
+/**
+ * Computes the orbits of the group generated by the automorphisms that fix every individualized node of the current path.
+ */
+static void build_orbits(CanonicalSearch* s) {
+    for (int u = 0; u < s->n; u++) {
+        s->parent[u] = u;
+    }
+    for (int i = 0; i < s->num_generators; i++) {
+        bool fixes = true;
+        for (int k = 0; k < s->support_size[i] && fixes; k++) {
+            fixes = !s->in_path[s->support[i][k]];
+        }
+        if (!fixes) {
+            continue;
+        }
+        for (int k = 0; k < s->support_size[i]; k++) {
+            int u = s->support[i][k];
+            int ru = find_root(s->parent, u);
+            int rv = find_root(s->parent, s->generators[i][u]);
+            if (ru != rv) {
+                s->parent[ru] = rv;
+            }
+        }
+    }
+}
+
+/**
+ * Visits a node of the search tree, whose partition is already refined:
+ * 1. Prunes the node if its trace is smaller than the trace of the best leaf, as every leaf below it is smaller.
+ * 2. Processes the leaf if the partition is discrete.
+ * 3. Otherwise individualizes, one at a time, every node of the target cell and refines the partition,
+ *    skipping the nodes in the same orbit of a node already tried under the automorphisms that fix the current path.
+ */
+static void search_node(CanonicalSearch* s, int depth) {
+    Partition* p = &s->levels[depth];
+    if (s->has_best && compare_trace(s->trace, depth, s->best_trace, s->best_depth, depth) < 0) {
+        return;
+    }
+    if (p->num_cells == s->n) {
+        process_leaf(s, p, depth);
+        return;
+    }
+    if (!ensure_level(s, depth + 1)) {
+        return;
+    }
+
+    int c = target_cell(p, s->n);
+    int size = p->cell_end[c] - c;
+    int* children = (int*)malloc(2 * size * sizeof(int));
+    if (children == NULL) {
+        return;
+    }
+    int* tried = children + size;
+    int num_tried = 0;
+    memcpy(children, p->lab + c, size * sizeof(int));
+
+    for (int k = 0; k < size; k++) {
+        int v = children[k];
+        if (num_tried > 0 && s->num_generators > 0) {
+            build_orbits(s);
+            int root = find_root(s->parent, v);
+            bool equivalent = false;
+            for (int t = 0; t < num_tried && !equivalent; t++) {
+                equivalent = find_root(s->parent, tried[t]) == root;
+            }
+            if (equivalent) {
+                continue;
+            }
+        }
+        tried[num_tried++] = v;
+
+        Partition* child = &s->levels[depth + 1];
+        memcpy(child->lab, p->lab, s->n * sizeof(int));
+        memcpy(child->cell, p->cell, s->n * sizeof(int));
+        memcpy(child->cell_end, p->cell_end, s->n * sizeof(int));
+        child->num_cells = p->num_cells;
+        individualize(child, v);
+        enqueue_cell(s, c);
+        s->trace[depth + 1] = refine(s, child);
+
+        s->in_path[v] = true;
+        search_node(s, depth + 1);
+        s->in_path[v] = false;
+    }
+    free(children);
+}
+
+/**
+ * Frees every buffer of the search.
+ */
+static void free_search(CanonicalSearch* s) {
+    if (s->levels != NULL) {
+        for (int d = 0; d <= s->n; d++) {
+            free(s->levels[d].lab);
+            free(s->levels[d].cell);
+            free(s->levels[d].cell_end);
+        }
+    }
+    if (s->generators != NULL) {
+        for (int i = 0; i < s->num_generators; i++) {
+            free(s->generators[i]);
+            free(s->support[i]);
+        }
+    }
+    free(s->levels);
+    free(s->count);
+    free(s->touched);
+    free(s->touched_cells);
+    free(s->cell_marked);
+    free(s->queue);
+    free(s->in_queue);
+    free(s->keys);
+    free(s->trace);
+    free(s->in_path);
+    free(s->inv);
+    free(s->row);
+    free(s->code);
+    free(s->best_trace);
+    free(s->best_lab);
+    free(s->best_code);
+    free(s->first_trace);
+    free(s->first_lab);
+    free(s->first_code);
+    free(s->generators);
+    free(s->support);
+    free(s->support_size);
+    free(s->parent);
+}
+
+/**
+ * Computes the certificate of a graph.
+ * 1. Builds the initial partition: a single cell, or one cell per color sorted by color value.
+ * 2. Refines it and explores the individualization-refinement tree, keeping the leaf with the greatest (trace, code).
+ * 3. The code of that leaf is the canonical code, its positions are the canonical labels.
+ */
+Certificate* compute_certificate(Graph* g, const int* colors) {
+    int n = g->num_nodes;
+    Certificate* cert = (Certificate*)calloc(1, sizeof(Certificate));
+    if (cert == NULL) {
+        fprintf(stderr, "ERROR: certificate allocation error");
+        return NULL;
+    }
+    int code_size = (colors != NULL) ? n : 0;
+    int max_degree = 0;
+    for (int u = 0; u < n; u++) {
+        code_size += 1 + g->nodes[u].num_neighbors;
+        if (g->nodes[u].num_neighbors > max_degree) {
+            max_degree = g->nodes[u].num_neighbors;
+        }
+    }
+    cert->num_nodes = n;
+    cert->num_edges = (code_size - ((colors != NULL) ? n : 0) - n) / 2;
+    cert->code_size = code_size;
+    cert->code = (int*)malloc((code_size > 0 ? code_size : 1) * sizeof(int));
+    cert->labeling = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (cert->code == NULL || cert->labeling == NULL) {
+        fprintf(stderr, "ERROR: certificate allocation error");
+        free_certificate(cert);
+        return NULL;
+    }
+    cert->hash = mix(mix(1469598103934665603ULL, n), code_size);
+    if (n == 0) {
+        return cert;
+    }
+
+    CanonicalSearch s;
+    memset(&s, 0, sizeof(CanonicalSearch));
+    s.g = g;
+    s.colors = colors;
+    s.n = n;
+    s.code_size = code_size;
+    s.count = (int*)calloc(n, sizeof(int));
+    s.touched = (int*)malloc(n * sizeof(int));
+    s.touched_cells = (int*)malloc(n * sizeof(int));
+    s.cell_marked = (bool*)calloc(n, sizeof(bool));
+    s.queue = (int*)malloc(n * sizeof(int));
+    s.in_queue = (bool*)calloc(n, sizeof(bool));
+    s.keys = (KeyedNode*)malloc(n * sizeof(KeyedNode));
+    s.levels = (Partition*)calloc(n + 1, sizeof(Partition));
+    s.trace = (unsigned long long*)malloc((n + 1) * sizeof(unsigned long long));
+    s.in_path = (bool*)calloc(n, sizeof(bool));
+    s.inv = (int*)malloc(n * sizeof(int));
+    s.row = (int*)malloc((max_degree > 0 ? max_degree : 1) * sizeof(int));
+    s.code = (int*)malloc(code_size * sizeof(int));
+    s.best_trace = (unsigned long long*)malloc((n + 1) * sizeof(unsigned long long));
+    s.best_lab = (int*)malloc(n * sizeof(int));
+    s.best_code = (int*)malloc(code_size * sizeof(int));
+    s.first_trace = (unsigned long long*)malloc((n + 1) * sizeof(unsigned long long));
+    s.first_lab = (int*)malloc(n * sizeof(int));
+    s.first_code = (int*)malloc(code_size * sizeof(int));
+    s.generators = (int**)malloc(GENERATORS_PER_NODE * n * sizeof(int*));
+    s.support = (int**)malloc(GENERATORS_PER_NODE * n * sizeof(int*));
+    s.support_size = (int*)malloc(GENERATORS_PER_NODE * n * sizeof(int));
+    s.parent = (int*)malloc(n * sizeof(int));
+    if (s.count == NULL || s.touched == NULL || s.touched_cells == NULL || s.cell_marked == NULL || s.queue == NULL ||
+        s.in_queue == NULL || s.keys == NULL || s.levels == NULL || s.trace == NULL || s.in_path == NULL || s.inv == NULL ||
+        s.row == NULL || s.code == NULL || s.best_trace == NULL || s.best_lab == NULL || s.best_code == NULL ||
+        s.first_trace == NULL || s.first_lab == NULL || s.first_code == NULL || s.generators == NULL || s.support == NULL ||
+        s.support_size == NULL || s.parent == NULL || !ensure_level(&s, 0)) {
+        fprintf(stderr, "ERROR: certificate allocation error");
+        free_search(&s);
+        free_certificate(cert);
+        return NULL;
+    }
+
+    /* Initial partition, one cell per color */
+    Partition* root = &s.levels[0];
+    unsigned long long h = 1469598103934665603ULL;
+    for (int u = 0; u < n; u++) {
+        s.keys[u].key = (colors != NULL) ? colors[u] : 0;
+        s.keys[u].node = u;
+    }
+    qsort(s.keys, n, sizeof(KeyedNode), compare_keyed_node);
+    root->num_cells = 0;
+    for (int i = 0; i < n; ) {
+        int j = i + 1;
+        while (j < n && s.keys[j].key == s.keys[i].key) {
+            j++;
+        }
+        for (int k = i; k < j; k++) {
+            root->lab[k] = s.keys[k].node;
+            root->cell[s.keys[k].node] = i;
+        }
+        root->cell_end[i] = j;
+        root->num_cells++;
+        enqueue_cell(&s, i);
+        h = mix(mix(h, s.keys[i].key), j - i);
+        i = j;
+    }
+    s.trace[0] = refine(&s, root) ^ h;
+
+    search_node(&s, 0);
+
+    memcpy(cert->code, s.best_code, code_size * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        cert->labeling[s.best_lab[i]] = i;
+    }
+    for (int i = 0; i < code_size; i++) {
+        cert->hash = mix(cert->hash, cert->code[i]);
+    }
+    cert->num_leaves = s.num_leaves;
+    cert->num_generators = s.num_generators;
+    free_search(&s);
+    return cert;
+}
+
+/**
+ * Two certificates are equal when the graphs have the same size and the same canonical code.
+ */
+bool certificates_equal(const Certificate* c1, const Certificate* c2) {
+    return c1->num_nodes == c2->num_nodes && c1->code_size == c2->code_size && c1->hash == c2->hash &&
+           memcmp(c1->code, c2->code, c1->code_size * sizeof(int)) == 0;
+}
+
+/**
+ * Maps every node of G1 to the node of G2 with the same canonical label.
+ */
+bool certificate_mapping(const Certificate* c1, const Certificate* c2, int* mapping) {
+    if (!certificates_equal(c1, c2)) {
+        return false;
+    }
+    int n = c1->num_nodes;
+    int* node_of_label = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (node_of_label == NULL) {
+        fprintf(stderr, "ERROR: certificate mapping allocation error");
+        return false;
+    }
+    for (int v = 0; v < n; v++) {
+        node_of_label[c2->labeling[v]] = v;
+    }
+    for (int u = 0; u < n; u++) {
+        mapping[u] = node_of_label[c1->labeling[u]];
+    }
+    free(node_of_label);
+    return true;
+}
+
+/**
+ * Frees the code, the labeling and the certificate itself.
+ */
+void free_certificate(Certificate* cert) {
+    if (cert == NULL) {
+        return;
+    }
+    free(cert->code);
+    free(cert->labeling);
+    free(cert);
+}
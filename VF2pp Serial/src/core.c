@@ -0,0 +1,191 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "forest.h"
+#include "signature.h"
+#include "core.h"
+
+static int compare_int(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Creates the subgraph induced by the nodes of the 2-core, renumbered in order (`local` gets the new index of each node of the 2-core).
+ */
+static Graph* core_graph(Graph* g, const bool* core, const int* core_nodes, int size, int* local) {
+    for(int i = 0; i < size; i++){
+        local[core_nodes[i]] = i;
+    }
+    Graph* sub = createGraph(size);
+    if(sub == NULL || sub->nodes == NULL){
+        fprintf(stderr, "ERROR: core graph allocation error");
+        free(sub);
+        return NULL;
+    }
+    for(int i = 0; i < size; i++){
+        Node* node = &g->nodes[core_nodes[i]];
+        int* list = (int*)malloc((node->num_neighbors + 1) * sizeof(int));
+        if(list == NULL){
+            fprintf(stderr, "ERROR: core graph allocation error");
+            freeGraph(sub);
+            return NULL;
+        }
+        int count = 0;
+        for(int j = 0; j < node->num_neighbors; j++){
+            if(core[node->neighborhood[j]]){
+                list[count++] = local[node->neighborhood[j]];
+            }
+        }
+        sub->nodes[i].neighborhood = list;
+        sub->nodes[i].num_neighbors = count;
+    }
+    return sub;
+}
+
+/**
+ * 1. Without nodes of degree 1 in G1 there is nothing to remove: the whole graphs are searched. So are graphs with self loops, which
+ *    the feasibility rules of the search do not count, so that the labels of the 2-cores could not be matched consistently.
+ * 2. Removes the hanging trees from both graphs (find_hanging_trees). The 2-cores must have the same size and the same multiset of
+ *    labels, otherwise the graphs are not isomorphic.
+ * 3. Builds the 2-cores as graphs, with the labels in their node keys (set_label_keys), and runs VF2++ on them.
+ * 4. Copies the mapping of the 2-cores to the graphs and maps the hanging trees (map_hanging_trees).
+ */
+int core_isomorphic(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats) {
+    int n = G1->num_nodes;
+    if(n == 0 || n != G2->num_nodes){
+        return -1;
+    }
+    bool pendant = false;
+    for(int u = 0; u < n; u++){
+        for(int i = 0; i < G1->nodes[u].num_neighbors; i++){
+            if(G1->nodes[u].neighborhood[i] == u){
+                return -1;
+            }
+        }
+        pendant = pendant || G1->nodes[u].num_neighbors == 1;
+    }
+    if(!pendant){
+        return -1;
+    }
+
+    // 2. Hanging trees
+    HangingTrees trees;
+    if(!find_hanging_trees(G1, G2, &trees)){
+        return -1;
+    }
+    int* core_nodes1 = (int*)malloc(n * sizeof(int));
+    int* core_nodes2 = (int*)malloc(n * sizeof(int));
+    int* labels1 = (int*)malloc(n * sizeof(int));
+    int* labels2 = (int*)malloc(n * sizeof(int));
+    int* local = (int*)malloc(n * sizeof(int));
+    int size1 = 0, size2 = 0;
+    int result = -1;
+    if(core_nodes1 == NULL || core_nodes2 == NULL || labels1 == NULL || labels2 == NULL || local == NULL){
+        fprintf(stderr, "ERROR: core allocation error");
+    }else{
+        for(int u = 0; u < n; u++){
+            if(trees.core1[u]){
+                labels1[size1] = trees.label1[u];
+                core_nodes1[size1++] = u;
+            }
+            if(trees.core2[u]){
+                labels2[size2] = trees.label2[u];
+                core_nodes2[size2++] = u;
+            }
+        }
+        if(size1 > 0 && size1 != size2){
+            result = 0;
+        }else if(size1 > 0){
+            qsort(labels1, size1, sizeof(int), compare_int);
+            qsort(labels2, size2, sizeof(int), compare_int);
+            result = (memcmp(labels1, labels2, size1 * sizeof(int)) == 0) ? -1 : 0;
+        }
+    }
+
+    // 3. Search on the 2-cores
+    VF2ppStats core_stats;
+    vf2pp_clear_stats(&core_stats);
+    if(result == -1 && size1 > 0){
+        VF2ppOptions core_options;
+        if(options != NULL){
+            core_options = *options;
+        }else{
+            vf2pp_default_options(&core_options);
+        }
+        core_options.symmetry_breaking = false;
+        Graph* C1 = core_graph(G1, trees.core1, core_nodes1, size1, local);
+        Graph* C2 = core_graph(G2, trees.core2, core_nodes2, size2, local);
+        for(int i = 0; i < size1; i++){
+            labels1[i] = trees.label1[core_nodes1[i]];
+            labels2[i] = trees.label2[core_nodes2[i]];
+        }
+        if(C1 != NULL && C2 != NULL && set_label_keys(C1, labels1, core_options.signatures)
+           && set_label_keys(C2, labels2, core_options.signatures)){
+            result = 0;
+            VF2ppState* state = vf2pp_init(C1, C2, &core_options);
+            if(state != NULL){
+                if(vf2pp_next(state, NULL)){
+                    result = 1;
+                }
+                core_stats = state->stats;
+                vf2pp_free(state);
+            }
+        }
+
+        // 4. Mapping
+        if(result == 1){
+            for(int u = 0; u < n; u++){
+                G1->nodes[u].mapped = -1;
+                G2->nodes[u].mapped = -1;
+            }
+            for(int i = 0; i < size1; i++){
+                int v = core_nodes2[C1->nodes[i].mapped];
+                G1->nodes[core_nodes1[i]].mapped = v;
+                G2->nodes[v].mapped = core_nodes1[i];
+            }
+            map_hanging_trees(&trees, G1, G2);
+        }
+        if(C1 != NULL) freeGraph(C1);
+        if(C2 != NULL) freeGraph(C2);
+    }
+
+    if(stats != NULL && result >= 0){
+        *stats = core_stats;
+    }
+    free(core_nodes1);
+    free(core_nodes2);
+    free(labels1);
+    free(labels2);
+    free(local);
+    free_hanging_trees(&trees);
+    return result;
+}
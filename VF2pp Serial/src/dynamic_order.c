@@ -0,0 +1,140 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file dynamic_order.c
+ * @brief This file contains the functions that keep the keys of the nodes of G1 and choose the next node of the search.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - bitset.h: Definition of the bitsets of the classes.
+ * - dynamic_order.h: Defines the keys and the tournament tree.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "graph.h"
+#include "bitset.h"
+#include "dynamic_order.h"
+
+/**
+ * Priority of u in the tournament tree: its key in the high half and its rank in the low half, so that the smaller priority is the
+ * node with the smaller key, and the earlier one in the static order on a tie.
+ */
+static inline uint64_t _priority(const DynamicOrder* order, int u) {
+    return ((uint64_t)(uint32_t)order->key[u] << 32) | (uint32_t)order->rank[u];
+}
+
+/**
+ * Allocates the keys and the tree.
+ * The key of every node is the one of T1_tilde, from the size of its class; then every inner node of the tree is computed from its
+ * children, from the last one to the root.
+ */
+bool init_dynamic_order(DynamicOrder* order, Graph* G1, const CandidateFilter* filter, const int* node_order) {
+    int n = G1->num_nodes;
+    memset(order, 0, sizeof(DynamicOrder));
+    order->num_nodes = n;
+    order->leaves = 1;
+    while (order->leaves < n) {
+        order->leaves *= 2;
+    }
+    order->key = (int*)malloc(n * sizeof(int));
+    order->tilde_key = (int*)malloc(n * sizeof(int));
+    order->rank = (int*)malloc(n * sizeof(int));
+    order->node_at = (int*)malloc(n * sizeof(int));
+    order->tree = (uint64_t*)malloc(2 * order->leaves * sizeof(uint64_t));
+    if (order->key == NULL || order->tilde_key == NULL || order->rank == NULL || order->node_at == NULL || order->tree == NULL) {
+        free_dynamic_order(order);
+        return false;
+    }
+    for (int d = 0; d < n; d++) {
+        order->rank[node_order[d]] = d;
+        order->node_at[d] = node_order[d];
+    }
+    for (int u = 0; u < n; u++) {
+        int size = 0;
+        if (filter->node_class[u] != -1) {
+            size = bitset_count(filter->class_bits + (size_t)filter->node_class[u] * filter->words, filter->words);
+        }
+        order->tilde_key[u] = (size == 0) ? 0 : n + size;
+        order->key[u] = order->tilde_key[u];
+    }
+    for (int i = 0; i < order->leaves; i++) {
+        order->tree[order->leaves + i] = (i < n) ? _priority(order, i) : UINT64_MAX;
+    }
+    for (int i = order->leaves - 1; i >= 1; i--) {
+        order->tree[i] = (order->tree[2 * i] < order->tree[2 * i + 1]) ? order->tree[2 * i] : order->tree[2 * i + 1];
+    }
+    return true;
+}
+
+/**
+ * Frees every array of the structure.
+ */
+void free_dynamic_order(DynamicOrder* order) {
+    free(order->key);
+    free(order->tilde_key);
+    free(order->rank);
+    free(order->node_at);
+    free(order->tree);
+    memset(order, 0, sizeof(DynamicOrder));
+}
+
+/**
+ * Sets the key of u and replays the matches of the tournament tree on the path from its leaf to the root. The priorities are
+ * distinct, so the replay stops at the first match whose winner does not change: the matches above it see the same priorities.
+ */
+void set_node_key(DynamicOrder* order, int u, int key) {
+    if (order->key[u] == key) {
+        return;
+    }
+    order->key[u] = key;
+    int i = order->leaves + u;
+    order->tree[i] = _priority(order, u);
+    for (i /= 2; i >= 1; i /= 2) {
+        uint64_t left = order->tree[2 * i];
+        uint64_t right = order->tree[2 * i + 1];
+        uint64_t winner = (left < right) ? left : right;
+        if (winner == order->tree[i]) {
+            return;
+        }
+        order->tree[i] = winner;
+    }
+}
+
+/**
+ * The node of the priority at the root of the tree, unless its key says that it is mapped.
+ */
+int select_node(const DynamicOrder* order) {
+    uint64_t best = order->tree[1];
+    if ((int)(best >> 32) == INT_MAX) {
+        return -1;
+    }
+    return order->node_at[(uint32_t)best];
+}
@@ -0,0 +1,325 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file endgame.c
+ * @brief This file contains the functions that match the last unmapped nodes of the search in a single step.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - bitset.h: Definition of the bit operations on words.
+ * - endgame.h: Defines the buffers of the endgame.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "bitset.h"
+#include "endgame.h"
+
+/**
+ * Reserves the buffers: the sets of nodes have one word per unmapped node, the numbers and the marks one element per node of
+ * the graphs.
+ */
+bool init_endgame(Endgame* endgame, int num_nodes, int threshold) {
+    memset(endgame, 0, sizeof(Endgame));
+    endgame->num_nodes = num_nodes;
+    endgame->threshold = threshold;
+    endgame->nodes1 = (int*)malloc(threshold * sizeof(int));
+    endgame->nodes2 = (int*)malloc(threshold * sizeof(int));
+    endgame->compatible = (uint64_t*)malloc(threshold * sizeof(uint64_t));
+    endgame->adjacent1 = (uint64_t*)malloc(threshold * sizeof(uint64_t));
+    endgame->adjacent2 = (uint64_t*)malloc(threshold * sizeof(uint64_t));
+    endgame->image = (int*)malloc(threshold * sizeof(int));
+    endgame->preimage = (int*)malloc(threshold * sizeof(int));
+    endgame->order = (int*)malloc(threshold * sizeof(int));
+    endgame->candidates = (uint64_t*)malloc(threshold * sizeof(uint64_t));
+    endgame->number1 = (int*)malloc(num_nodes * sizeof(int));
+    endgame->number2 = (int*)malloc(num_nodes * sizeof(int));
+    endgame->marked = (bool*)calloc(num_nodes, sizeof(bool));
+    if (endgame->nodes1 == NULL || endgame->nodes2 == NULL || endgame->compatible == NULL || endgame->adjacent1 == NULL
+        || endgame->adjacent2 == NULL || endgame->image == NULL || endgame->preimage == NULL || endgame->order == NULL
+        || endgame->candidates == NULL || endgame->number1 == NULL || endgame->number2 == NULL || endgame->marked == NULL) {
+        free_endgame(endgame);
+        return false;
+    }
+    for (int x = 0; x < num_nodes; x++) {
+        endgame->number1[x] = -1;
+        endgame->number2[x] = -1;
+    }
+    return true;
+}
+
+/**
+ * Frees every buffer of the endgame.
+ */
+void free_endgame(Endgame* endgame) {
+    free(endgame->nodes1);
+    free(endgame->nodes2);
+    free(endgame->compatible);
+    free(endgame->adjacent1);
+    free(endgame->adjacent2);
+    free(endgame->image);
+    free(endgame->preimage);
+    free(endgame->order);
+    free(endgame->candidates);
+    free(endgame->number1);
+    free(endgame->number2);
+    free(endgame->marked);
+    memset(endgame, 0, sizeof(Endgame));
+}
+
+/**
+ * Returns the key of a node, the one that its image must share (see find_candidates.h).
+ */
+static uint64_t _key(Graph* g, bool signatures, int x) {
+    return signatures ? g->signature[x] : (uint64_t)g->nodes[x].num_neighbors;
+}
+
+/**
+ * Counts the mapped neighbors of x, marking them when `marked` is not NULL.
+ */
+static int _mapped_neighbors(Graph* g, int x, bool* marked) {
+    int count = 0;
+    for (int i = 0; i < g->nodes[x].num_neighbors; i++) {
+        int w = g->nodes[x].neighborhood[i];
+        if (g->nodes[w].mapped != -1) {
+            count++;
+            if (marked != NULL) {
+                marked[w] = true;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * Finds the sets of the unmapped nodes of G1, numbered in `nodes1`: the nodes of G2 compatible with each of them and their
+ * unmapped neighbors. The mapped neighbors of u are marked, so that a node v of G2 with as many mapped neighbors, all preimages
+ * of marked nodes, has the same mapped neighbors as the images of the ones of u. Returns false if a node has no compatible node.
+ */
+static bool _compatible_sets(Endgame* endgame, Graph* G1, Graph* G2, int k) {
+    bool signatures = G1->signature != NULL && G2->signature != NULL;
+    for (int i = 0; i < k; i++) {
+        int u = endgame->nodes1[i];
+        int count = _mapped_neighbors(G1, u, endgame->marked);
+        uint64_t key = _key(G1, signatures, u);
+        uint64_t compatible = 0;
+        for (int j = 0; j < k; j++) {
+            int v = endgame->nodes2[j];
+            if (G2->nodes[v].num_neighbors != G1->nodes[u].num_neighbors || _key(G2, signatures, v) != key
+                || _mapped_neighbors(G2, v, NULL) != count) {
+                continue;
+            }
+            bool same = true;
+            for (int x = 0; x < G2->nodes[v].num_neighbors && same; x++) {
+                int w = G2->nodes[v].neighborhood[x];
+                same = G2->nodes[w].mapped == -1 || endgame->marked[G2->nodes[w].mapped];
+            }
+            if (same) {
+                compatible |= (uint64_t)1 << j;
+            }
+        }
+        for (int x = 0; x < G1->nodes[u].num_neighbors; x++) {
+            endgame->marked[G1->nodes[u].neighborhood[x]] = false;
+        }
+        endgame->compatible[i] = compatible;
+        if (compatible == 0) {
+            return false;
+        }
+        uint64_t adjacent = 0;
+        for (int x = 0; x < G1->nodes[u].num_neighbors; x++) {
+            int number = endgame->number1[G1->nodes[u].neighborhood[x]];
+            if (number != -1) {
+                adjacent |= (uint64_t)1 << number;
+            }
+        }
+        endgame->adjacent1[i] = adjacent;
+    }
+    for (int j = 0; j < k; j++) {
+        int v = endgame->nodes2[j];
+        uint64_t adjacent = 0;
+        for (int x = 0; x < G2->nodes[v].num_neighbors; x++) {
+            int number = endgame->number2[G2->nodes[v].neighborhood[x]];
+            if (number != -1) {
+                adjacent |= (uint64_t)1 << number;
+            }
+        }
+        endgame->adjacent2[j] = adjacent;
+    }
+    return true;
+}
+
+/**
+ * Looks for an augmenting path from the unmatched node i of G1 through the compatible pairs (Kuhn's algorithm), the nodes of G2
+ * already visited being the bits of `visited`.
+ */
+static bool _augment(Endgame* endgame, int i, uint64_t* visited) {
+    for (uint64_t word = endgame->compatible[i] & ~*visited; word != 0; word = endgame->compatible[i] & ~*visited) {
+        int j = bitset_lowest_bit(word);
+        *visited |= (uint64_t)1 << j;
+        if (endgame->preimage[j] == -1 || _augment(endgame, endgame->preimage[j], visited)) {
+            endgame->image[i] = j;
+            endgame->preimage[j] = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Finds a perfect matching of the compatible pairs, in `image` and `preimage`. Returns false if there is none.
+ */
+static bool _perfect_matching(Endgame* endgame, int k) {
+    for (int i = 0; i < k; i++) {
+        endgame->image[i] = -1;
+        endgame->preimage[i] = -1;
+    }
+    for (int i = 0; i < k; i++) {
+        uint64_t visited = 0;
+        if (!_augment(endgame, i, &visited)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Tries the bijections between the unmapped nodes made of compatible pairs, assigning the nodes of G1 in `order` (fewest
+ * compatible nodes first). When node i is assigned to node j, the unmapped neighbors of i already assigned must be mapped
+ * exactly to the unmapped neighbors of j already used; the test is a comparison of two words. Returns ENDGAME_FOUND with the
+ * bijection in `image`, ENDGAME_NONE, or ENDGAME_UNKNOWN after ENDGAME_MAX_STEPS assignments.
+ */
+static int _exhaustive(Endgame* endgame, int k) {
+    for (int p = 0; p < k; p++) {
+        int i = p;
+        int count = bitset_count(&endgame->compatible[i], 1);
+        int q = p;
+        while (q > 0 && bitset_count(&endgame->compatible[endgame->order[q - 1]], 1) > count) {
+            endgame->order[q] = endgame->order[q - 1];
+            q--;
+        }
+        endgame->order[q] = i;
+        endgame->image[i] = -1;
+    }
+    uint64_t used = 0;
+    uint64_t assigned = 0;
+    long steps = 0;
+    int pos = 0;
+    endgame->candidates[0] = endgame->compatible[endgame->order[0]];
+    while (pos >= 0) {
+        int i = endgame->order[pos];
+        if (endgame->image[i] != -1) {
+            used &= ~((uint64_t)1 << endgame->image[i]);
+            assigned &= ~((uint64_t)1 << i);
+            endgame->image[i] = -1;
+        }
+        if (endgame->candidates[pos] == 0) {
+            pos--;
+            continue;
+        }
+        int j = bitset_lowest_bit(endgame->candidates[pos]);
+        endgame->candidates[pos] &= endgame->candidates[pos] - 1;
+        if (++steps > ENDGAME_MAX_STEPS) {
+            return ENDGAME_UNKNOWN;
+        }
+        uint64_t expected = 0;
+        for (uint64_t word = endgame->adjacent1[i] & assigned; word != 0; word &= word - 1) {
+            expected |= (uint64_t)1 << endgame->image[bitset_lowest_bit(word)];
+        }
+        if (expected != (endgame->adjacent2[j] & used)) {
+            continue;
+        }
+        endgame->image[i] = j;
+        used |= (uint64_t)1 << j;
+        assigned |= (uint64_t)1 << i;
+        if (++pos == k) {
+            return ENDGAME_FOUND;
+        }
+        endgame->candidates[pos] = endgame->compatible[endgame->order[pos]] & ~used;
+    }
+    return ENDGAME_NONE;
+}
+
+/**
+ * 1. Numbers the unmapped nodes of both graphs; gives up if they are more than the threshold, for which the buffers have room.
+ * 2. Finds the compatible pairs and the edges between unmapped nodes (_compatible_sets); fails if a node of G1 has no
+ *    compatible node, or if the compatible pairs have no perfect matching (_perfect_matching).
+ * 3. When the unmapped nodes of G1 are not adjacent to each other, all their neighbors are mapped; so are the ones of their
+ *    compatible nodes, which have the same number of mapped neighbors and the same degree. The matching is then a completion.
+ *    Otherwise the bijections are tried exhaustively (_exhaustive).
+ * 4. Maps the pairs of the completion found, and clears the numbers of the unmapped nodes for the next endgame.
+ */
+int solve_endgame(Endgame* endgame, Graph* G1, Graph* G2) {
+    int n = endgame->num_nodes;
+    int k = 0;
+    int k2 = 0;
+    for (int x = 0; x < n; x++) {
+        k += (G1->nodes[x].mapped == -1);
+        k2 += (G2->nodes[x].mapped == -1);
+    }
+    if (k == 0 || k > endgame->threshold || k2 != k) {
+        return ENDGAME_UNKNOWN;
+    }
+    k = 0;
+    k2 = 0;
+    for (int x = 0; x < n; x++) {
+        if (G1->nodes[x].mapped == -1) {
+            endgame->number1[x] = k;
+            endgame->nodes1[k++] = x;
+        }
+        if (G2->nodes[x].mapped == -1) {
+            endgame->number2[x] = k2;
+            endgame->nodes2[k2++] = x;
+        }
+    }
+
+    int result = ENDGAME_NONE;
+    if (_compatible_sets(endgame, G1, G2, k) && _perfect_matching(endgame, k)) {
+        bool independent = true;
+        for (int i = 0; i < k && independent; i++) {
+            independent = endgame->adjacent1[i] == 0;
+        }
+        result = independent ? ENDGAME_FOUND : _exhaustive(endgame, k);
+    }
+    if (result == ENDGAME_FOUND) {
+        for (int i = 0; i < k; i++) {
+            int u = endgame->nodes1[i];
+            int v = endgame->nodes2[endgame->image[i]];
+            G1->nodes[u].mapped = v;
+            G2->nodes[v].mapped = u;
+        }
+    }
+    for (int i = 0; i < k; i++) {
+        endgame->number1[endgame->nodes1[i]] = -1;
+    }
+    for (int j = 0; j < k2; j++) {
+        endgame->number2[endgame->nodes2[j]] = -1;
+    }
+    return result;
+}
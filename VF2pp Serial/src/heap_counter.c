@@ -0,0 +1,83 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file heap_counter.c
+ * @brief This file contains the counter of the heap calls made by the program.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - heap_counter.h: Definition of the counter of the heap calls.
+ */
+
+#include <stddef.h>
+#include "heap_counter.h"
+
+#ifdef VF2PP_COUNT_ALLOCATIONS
+
+static long counter = 0;
+
+/* Functions of the C library, renamed by the --wrap option of the linker */
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t num, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+/**
+ * Every wrapper counts the call (atomically, since the program may use several threads) and forwards it to the C library.
+ */
+void* __wrap_malloc(size_t size) {
+    __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t num, size_t size) {
+    __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+    return __real_calloc(num, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) {
+    __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+    __real_free(ptr);
+}
+
+long heap_calls(void) {
+    return __atomic_load_n(&counter, __ATOMIC_RELAXED);
+}
+
+#else
+
+long heap_calls(void) {
+    return -1;
+}
+
+#endif
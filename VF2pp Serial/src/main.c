@@ -26,6 +26,9 @@
  */
 #include "graph.h"
 #include "vf2pp.h"
+#include "enumerate.h"
+#include "canonical.h"
+#include "bitset.h"
 #include <stdio.h>
 #include <limits.h>
 #include <string.h>
@@ -38,19 +41,116 @@ int main(int argc, char *argv[]) {
 /* Enable/Disable the verbose mode (printing more information during the run) */
     int VERBOSE = 0;
 
+    /* Enumeration mode: find all the mappings instead of stopping at the first one */
+    bool ENUMERATE = false;
+    bool COUNT_ONLY = false;
+    long MAX_MAPPINGS = 0;
+    const char* MAPPINGS_FILE = NULL;
+
+    /* Optional features of the VF2++ search */
+    VF2ppOptions SEARCH_OPTIONS;
+    vf2pp_default_options(&SEARCH_OPTIONS);
+
+    /* Compare the canonical certificates first, running VF2++ only when they are equal */
+    bool CERTIFICATE = false;
+
+    /* Mappings file whose first mapping is the hint of the learned value ordering */
+    const char* HINT_FILE = NULL;
+
     if(argc < 3){
         fprintf(stderr, "ERROR: wrong number of arguments in command line.\n");
-        fprintf(stderr, "Usage: %s <token_file_name.txt> <pattern_file_name.txt> <OPTIONAL:VERBOSE>\n", argv[0]);
+        fprintf(stderr, "Usage: %s <token_file_name.txt> <pattern_file_name.txt> <OPTIONAL:VERBOSE> <OPTIONAL:--all|--count|--max=N|--out=file.bin|--symmetry|--signatures|--nogoods|--forward-checking|--dynamic-order|--all-different=K|--arc-consistency|--value-order=NAME|--hint=file.bin|--endgame=K|--fallback=N|--restarts=N|--seed=S|--certificate>\n", argv[0]);
         return EXIT_FAILURE;
-    }else if(argc == 4){
-        char *endptr;
-        long int val = strtol(argv[3], &endptr, 10);
-        if (argv[3] != endptr && *endptr == '\0') {
-            if (val == 0 || val == 1) {
-                VERBOSE = (int)val;
+    }
+    for(int i = 3; i < argc; i++){
+        if(strcmp(argv[i], "--all") == 0){
+            ENUMERATE = true;
+        }else if(strcmp(argv[i], "--count") == 0){
+            ENUMERATE = true;
+            COUNT_ONLY = true;
+        }else if(strncmp(argv[i], "--max=", 6) == 0){
+            char *endptr;
+            long int val = strtol(argv[i] + 6, &endptr, 10);
+            if (argv[i] + 6 != endptr && *endptr == '\0' && val > 0) {
+                ENUMERATE = true;
+                MAX_MAPPINGS = val;
+            }else{
+                fprintf(stderr, "WARNING: --max must be a positive integer. Ignoring it.\n");
+            }
+        }else if(strncmp(argv[i], "--out=", 6) == 0){
+            ENUMERATE = true;
+            MAPPINGS_FILE = argv[i] + 6;
+        }else if(strcmp(argv[i], "--symmetry") == 0){
+            SEARCH_OPTIONS.symmetry_breaking = true;
+        }else if(strcmp(argv[i], "--signatures") == 0){
+            SEARCH_OPTIONS.signatures = true;
+        }else if(strcmp(argv[i], "--nogoods") == 0){
+            SEARCH_OPTIONS.nogoods = true;
+        }else if(strcmp(argv[i], "--forward-checking") == 0){
+            SEARCH_OPTIONS.forward_checking = true;
+        }else if(strcmp(argv[i], "--dynamic-order") == 0){
+            SEARCH_OPTIONS.dynamic_order = true;
+        }else if(strcmp(argv[i], "--arc-consistency") == 0){
+            SEARCH_OPTIONS.arc_consistency = true;
+        }else if(strncmp(argv[i], "--all-different=", 16) == 0){
+            char *endptr;
+            long int val = strtol(argv[i] + 16, &endptr, 10);
+            if (argv[i] + 16 != endptr && *endptr == '\0' && val > 0 && val <= INT_MAX) {
+                SEARCH_OPTIONS.all_different_period = (int)val;
+            }else{
+                fprintf(stderr, "WARNING: --all-different must be a positive integer. Ignoring it.\n");
+            }
+        }else if(strncmp(argv[i], "--value-order=", 14) == 0){
+            int strategy = value_order_from_name(argv[i] + 14);
+            if(strategy >= 0){
+                SEARCH_OPTIONS.value_order = strategy;
+            }else{
+                fprintf(stderr, "WARNING: --value-order must be scan, rarest, unmapped, learned or random. Ignoring it.\n");
+            }
+        }else if(strncmp(argv[i], "--endgame=", 10) == 0){
+            char *endptr;
+            long int val = strtol(argv[i] + 10, &endptr, 10);
+            if (argv[i] + 10 != endptr && *endptr == '\0' && val > 0 && val <= ENDGAME_MAX_NODES) {
+                SEARCH_OPTIONS.endgame_threshold = (int)val;
+            }else{
+                fprintf(stderr, "WARNING: --endgame must be an integer in [1,%d]. Ignoring it.\n", ENDGAME_MAX_NODES);
             }
+        }else if(strncmp(argv[i], "--fallback=", 11) == 0){
+            char *endptr;
+            long int val = strtol(argv[i] + 11, &endptr, 10);
+            if (argv[i] + 11 != endptr && *endptr == '\0' && val > 0) {
+                SEARCH_OPTIONS.fallback_states = val;
+            }else{
+                fprintf(stderr, "WARNING: --fallback must be a positive integer. Ignoring it.\n");
+            }
+        }else if(strncmp(argv[i], "--restarts=", 11) == 0){
+            char *endptr;
+            long int val = strtol(argv[i] + 11, &endptr, 10);
+            if (argv[i] + 11 != endptr && *endptr == '\0' && val > 0) {
+                SEARCH_OPTIONS.restart_base = val;
+            }else{
+                fprintf(stderr, "WARNING: --restarts must be a positive integer. Ignoring it.\n");
+            }
+        }else if(strncmp(argv[i], "--seed=", 7) == 0){
+            char *endptr;
+            unsigned long long val = strtoull(argv[i] + 7, &endptr, 10);
+            if (argv[i] + 7 != endptr && *endptr == '\0') {
+                SEARCH_OPTIONS.seed = (uint64_t)val;
+            }else{
+                fprintf(stderr, "WARNING: --seed must be a non-negative integer. Ignoring it.\n");
+            }
+        }else if(strncmp(argv[i], "--hint=", 7) == 0){
+            HINT_FILE = argv[i] + 7;
+        }else if(strcmp(argv[i], "--certificate") == 0){
+            CERTIFICATE = true;
         }else{
-            fprintf(stderr, "WARNING: VERBOSE must be 0 or 1. Setting VERBOSE mode to 0.\n");
+            char *endptr;
+            long int val = strtol(argv[i], &endptr, 10);
+            if (argv[i] != endptr && *endptr == '\0' && (val == 0 || val == 1)) {
+                VERBOSE = (int)val;
+            }else{
+                fprintf(stderr, "WARNING: VERBOSE must be 0 or 1. Setting VERBOSE mode to 0.\n");
+            }
         }
     }
 /******************** GRAPHS MANAGER LOGIC ********************/
@@ -82,9 +182,22 @@ int main(int argc, char *argv[]) {
     if(VERBOSE){
         fprintf(stderr, "Token graph path: %s\n", TokenGraph);
         fprintf(stderr, "Pattern graph path: %s\n", PatternGraph);
+        fprintf(stderr, "Bitset kernels: %s\n", bitset_kernel_name());
         printGraph(G1);
         printGraph(G2);
     }
+    /* OPTIONAL: Read the mapping that the learned value ordering tries first */
+    int* hint = NULL;
+    if(HINT_FILE != NULL){
+        hint = (int*)malloc(G1->num_nodes * sizeof(int));
+        if(hint != NULL && mapping_file_read(HINT_FILE, G1->num_nodes, hint)){
+            SEARCH_OPTIONS.value_hint = hint;
+            SEARCH_OPTIONS.value_hint_nodes = G1->num_nodes;
+        }
+    }
+    if(SEARCH_OPTIONS.value_order == VALUE_ORDER_LEARNED && SEARCH_OPTIONS.value_hint == NULL){
+        fprintf(stderr, "WARNING: --value-order=learned needs a mapping read with --hint. Trying the candidates in scan order.\n");
+    }
     end = clock();
     loadGraph = ((double)(end - start))/CLOCKS_PER_SEC;
 /************************ VF2++ LOGIC ************************/
@@ -92,9 +205,72 @@ int main(int argc, char *argv[]) {
     /* Initialize the isomorph check to false */
     bool isIso = false;
 
-    /* Check results with VF2++ algorithm */
-    isIso = vf2pp_is_isomorphic(G1, G2);
-    
+    /* Different certificates prove that the graphs are not isomorphic, so VF2++ is skipped */
+    bool skipSearch = false;
+    if(CERTIFICATE){
+        Certificate* C1 = compute_certificate(G1, NULL);
+        Certificate* C2 = compute_certificate(G2, NULL);
+        if(C1 != NULL && C2 != NULL){
+            skipSearch = !certificates_equal(C1, C2);
+            if(VERBOSE){
+                fprintf(stderr, "Certificate of G1: %016llx (%ld leaves, %d automorphisms).\n", C1->hash, C1->num_leaves, C1->num_generators);
+                fprintf(stderr, "Certificate of G2: %016llx (%ld leaves, %d automorphisms).\n", C2->hash, C2->num_leaves, C2->num_generators);
+            }
+        }
+        free_certificate(C1);
+        free_certificate(C2);
+    }
+
+    if(skipSearch){
+        if(ENUMERATE){
+            fprintf(stderr, "Mappings found: 0\n");
+        }
+    }else if(ENUMERATE){
+        /* Find all the mappings, streaming them to the binary file if requested */
+        MappingWriter* writer = NULL;
+        if(MAPPINGS_FILE != NULL && !COUNT_ONLY){
+            writer = mapping_writer_open(MAPPINGS_FILE, G1->num_nodes);
+        }
+        EnumerationOptions options;
+        options.max_mappings = MAX_MAPPINGS;
+        options.count_only = COUNT_ONLY || writer == NULL;
+        options.callback = (writer != NULL) ? mapping_writer_write : NULL;
+        options.user_data = writer;
+        options.search = &SEARCH_OPTIONS;
+
+        long num_mappings = vf2pp_enumerate(G1, G2, &options);
+        mapping_writer_close(writer);
+        isIso = num_mappings > 0;
+        fprintf(stderr, "Mappings found: %ld\n", num_mappings);
+    }else{
+        /* Check results with VF2++ algorithm */
+        VF2ppStats stats;
+        isIso = vf2pp_is_isomorphic_with_options(G1, G2, &SEARCH_OPTIONS, &stats);
+        if(VERBOSE){
+            fprintf(stderr, "States explored: %ld.\n", stats.num_states);
+            if(stats.heap_calls >= 0){
+                fprintf(stderr, "Heap calls in the search loop: %ld.\n", stats.heap_calls);
+            }
+            if(stats.nogood_lookups > 0){
+                fprintf(stderr, "Nogood table: %ld hits in %ld lookups (%.1f%%).\n", stats.nogood_hits, stats.nogood_lookups, 100.0 * stats.nogood_hits / stats.nogood_lookups);
+            }
+            fprintf(stderr, "Value ordering: %s (%ld states were the first candidate of their node).\n", value_order_name(stats.value_order), stats.first_choices);
+            if(stats.endgames > 0){
+                fprintf(stderr, "Endgames: %ld.\n", stats.endgames);
+            }
+            if(stats.restarts > 0){
+                fprintf(stderr, "Restarts: %ld.\n", stats.restarts);
+            }
+            if(stats.fallbacks > 0){
+                fprintf(stderr, "Stalled searches decided by the canonical certificates: %ld.\n", stats.fallbacks);
+            }
+        }
+        if(VERBOSE && G1->symmetry != NULL){
+            fprintf(stderr, "Symmetry of G1: %d orbits, %d generators.\n", G1->symmetry->num_orbits, G1->symmetry->num_generators);
+        }
+    }
+
+    end = clock();
     VF2pp =  ((double)(end - start))/CLOCKS_PER_SEC;
 
     if(isIso){
@@ -105,8 +281,8 @@ int main(int argc, char *argv[]) {
     /* Free the memory before exiting */
     freeGraph(G1);
     freeGraph(G2);
+    free(hint);
 
-    end = clock();
     printf("%.4f,%.4f\n", loadGraph, VF2pp);
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,259 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file signature.c
+ * @brief This file contains the functions that compute the structural signatures of the nodes.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - signature.h: Definition of the structural signatures of the nodes.
+ * - graph.h: Definition of graph structure.
+ * - bitset.h: Definition of the adjacency bitsets and of their kernels.
+ * - find_candidates.h: Size limit of the graphs handled with the adjacency bitsets.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "graph.h"
+#include "bitset.h"
+#include "find_candidates.h"
+#include "signature.h"
+
+/**
+ * Scrambles the bits of a value (splitmix64 finalizer), so that close values give unrelated hashes.
+ */
+static uint64_t scramble(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Combines the invariants of a node into its signature.
+ * The degrees of the neighbors are summed after scrambling them, which hashes their multiset without sorting it.
+ */
+static uint64_t node_signature(Graph* g, int u, long twice_triangles, int two_hop) {
+    uint64_t neighbor_degrees = 0;
+    for (int i = 0; i < g->nodes[u].num_neighbors; i++) {
+        neighbor_degrees += scramble((uint64_t)g->nodes[g->nodes[u].neighborhood[i]].num_neighbors);
+    }
+    uint64_t h = scramble((uint64_t)g->nodes[u].num_neighbors);
+    h = scramble(h ^ (uint64_t)twice_triangles);
+    h = scramble(h ^ neighbor_degrees);
+    return scramble(h ^ (uint64_t)two_hop);
+}
+
+/**
+ * Counts of `u` with the adjacency bitsets, using a scratch bitset (`reach`):
+ *  - every triangle through u is an edge (v, w) between two neighbors, counted once from v and once from w: twice the triangles are
+ *    the sum, over the neighbors v, of the popcount of N(u) AND N(v). The popcount of an edge (u, v) is computed once, by its
+ *    smaller endpoint, and added to both endpoints (atomically, since v may belong to another thread);
+ *  - the nodes at distance 1 or 2 are N(u) OR the neighborhoods of the neighbors, without u itself.
+ */
+static void counts_bitset(Graph* g, const uint64_t* adjacency, int words, int u, uint64_t* reach, long* triangles, int* two_hop) {
+    const uint64_t* row_u = adjacency + (size_t)u * words;
+    long local = 0;
+    memcpy(reach, row_u, words * sizeof(uint64_t));
+    for (int i = 0; i < g->nodes[u].num_neighbors; i++) {
+        int v = g->nodes[u].neighborhood[i];
+        const uint64_t* row_v = adjacency + (size_t)v * words;
+        if (v > u) {
+            long common = bitset_and_count(row_u, row_v, words);
+            local += common;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            triangles[v] += common;
+        }
+        for (int k = 0; k < words; k++) {
+            reach[k] |= row_v[k];
+        }
+    }
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    triangles[u] += local;
+    bitset_clear(reach, u);
+    two_hop[u] = bitset_count(reach, words);
+}
+
+/**
+ * Same counts with the neighbor lists, marking the neighbors of u (`neighbor_mark`) and the nodes already reached (`reach_mark`)
+ * with the index of u, so that the marks never need to be cleared. Each triangle through u is found twice.
+ */
+static void counts_lists(Graph* g, int u, int* neighbor_mark, int* reach_mark, long* triangles, int* two_hop) {
+    long found = 0;
+    int reached = g->nodes[u].num_neighbors;
+    reach_mark[u] = u;
+    for (int i = 0; i < g->nodes[u].num_neighbors; i++) {
+        int v = g->nodes[u].neighborhood[i];
+        neighbor_mark[v] = u;
+        reach_mark[v] = u;
+    }
+    for (int i = 0; i < g->nodes[u].num_neighbors; i++) {
+        Node* v = &g->nodes[g->nodes[u].neighborhood[i]];
+        for (int j = 0; j < v->num_neighbors; j++) {
+            int w = v->neighborhood[j];
+            if (neighbor_mark[w] == u) {
+                found++;
+            }
+            if (reach_mark[w] != u) {
+                reach_mark[w] = u;
+                reached++;
+            }
+        }
+    }
+    triangles[u] = found;
+    two_hop[u] = reached;
+}
+
+/**
+ * Computes the signatures of the graph the first time they are needed:
+ * 1. Chooses the bitset version when the graph is small enough for its adjacency bitsets, the neighbor lists otherwise.
+ * 2. Allocates the counts and one scratch buffer for each thread (a single one without OpenMP).
+ * 3. Computes the counts of each node; the nodes are independent, so with OpenMP they are shared among the threads.
+ * 4. Hashes the counts of each node (twice the triangles) into its signature.
+ */
+uint64_t* graph_signatures(Graph* g) {
+    if (g->signature != NULL) {
+        return g->signature;
+    }
+    int n = g->num_nodes;
+    int words = bitset_words(n);
+    const uint64_t* adjacency = (n <= CANDIDATE_BITSET_MAX_NODES) ? graph_adjacency(g) : NULL;
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    size_t scratch_size = (adjacency != NULL) ? (size_t)words * sizeof(uint64_t) : 2 * (size_t)n * sizeof(int);
+    uint64_t* signature = (uint64_t*)malloc((n > 0 ? n : 1) * sizeof(uint64_t));
+    long* triangles = (long*)calloc(n > 0 ? n : 1, sizeof(long));
+    int* two_hop = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    char* scratch = (char*)malloc(threads * scratch_size + 1);
+    if (signature == NULL || triangles == NULL || two_hop == NULL || scratch == NULL) {
+        fprintf(stderr, "ERROR: node signatures allocation error");
+        free(signature);
+        free(triangles);
+        free(two_hop);
+        free(scratch);
+        return NULL;
+    }
+    if (adjacency == NULL) {
+        for (int t = 0; t < 2 * threads; t++) {
+            int* marks = (int*)scratch + (size_t)t * n;
+            for (int i = 0; i < n; i++) {
+                marks[i] = -1;
+            }
+        }
+    }
+    bitset_init_kernels();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (int u = 0; u < n; u++) {
+        int thread = 0;
+#ifdef _OPENMP
+        thread = omp_get_thread_num();
+#endif
+        char* buffer = scratch + thread * scratch_size;
+        if (adjacency != NULL) {
+            counts_bitset(g, adjacency, words, u, (uint64_t*)buffer, triangles, two_hop);
+        } else {
+            counts_lists(g, u, (int*)buffer, (int*)buffer + n, triangles, two_hop);
+        }
+    }
+    for (int u = 0; u < n; u++) {
+        signature[u] = node_signature(g, u, triangles[u], two_hop[u]);
+    }
+
+    free(scratch);
+    free(triangles);
+    free(two_hop);
+    g->signature = signature;
+    return signature;
+}
+
+/**
+ * Compares the signatures of two nodes, for qsort.
+ */
+static int compare_signatures(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Sorts a copy of the signatures of both graphs and compares them.
+ */
+bool signatures_compatible(Graph* G1, Graph* G2) {
+    int n = G1->num_nodes;
+    uint64_t* s1 = graph_signatures(G1);
+    uint64_t* s2 = graph_signatures(G2);
+    uint64_t* sorted = (uint64_t*)malloc(2 * (size_t)(n > 0 ? n : 1) * sizeof(uint64_t));
+    if (s1 == NULL || s2 == NULL || sorted == NULL) {
+        free(sorted);
+        return true;
+    }
+    memcpy(sorted, s1, n * sizeof(uint64_t));
+    memcpy(sorted + n, s2, n * sizeof(uint64_t));
+    qsort(sorted, n, sizeof(uint64_t), compare_signatures);
+    qsort(sorted + n, n, sizeof(uint64_t), compare_signatures);
+    bool compatible = memcmp(sorted, sorted + n, n * sizeof(uint64_t)) == 0;
+    free(sorted);
+    return compatible;
+}
+
+/**
+ * Starts from the structural signatures (computed and cached if needed) or from the degrees, and replaces the high 32 bits
+ * of each key with the label of the node.
+ */
+bool set_label_keys(Graph* g, const int* label, bool signatures) {
+    uint64_t* keys = signatures ? graph_signatures(g) : NULL;
+    if (keys == NULL) {
+        free(g->signature);
+        keys = (uint64_t*)malloc((g->num_nodes + 1) * sizeof(uint64_t));
+        g->signature = keys;
+        if (keys == NULL) {
+            fprintf(stderr, "ERROR: node keys allocation error");
+            return false;
+        }
+        for (int i = 0; i < g->num_nodes; i++) {
+            keys[i] = (uint64_t)g->nodes[i].num_neighbors;
+        }
+    }
+    for (int i = 0; i < g->num_nodes; i++) {
+        keys[i] = ((uint64_t)label[i] << 32) | (keys[i] & 0xffffffffULL);
+    }
+    return true;
+}
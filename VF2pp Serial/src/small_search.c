@@ -0,0 +1,173 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file small_search.c
+ * @brief This file contains the VF2++ search specialized for graphs of at most 128 nodes, generated for sets of one and two words.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - bitset.h: Definition of the bit operations on words.
+ * - node_ordering.h: Definition of the matching order.
+ * - signature.h: Definition of the structural signatures of the nodes.
+ * - vf2pp.h: Definition of the options and the statistics of the search.
+ * - small_search.h: Defines the search on small graphs.
+ * - small_search_template.h: Template of the search, included for each width.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+#include "bitset.h"
+#include "node_ordering.h"
+#include "signature.h"
+#include "vf2pp.h"
+#include "small_search.h"
+
+/**
+ * Counts the bits set in a word.
+ */
+static inline int _word_count(uint64_t word) {
+#ifdef __GNUC__
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word != 0; word &= word - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * Compares two keys, for qsort and bsearch.
+ */
+static int _compare_keys(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* Sets of at most 64 nodes: a single word */
+typedef uint64_t Small64;
+
+static inline Small64 small64_none(void) { return 0; }
+static inline Small64 small64_bit(int i) { return (uint64_t)1 << i; }
+static inline Small64 small64_or(Small64 a, Small64 b) { return a | b; }
+static inline Small64 small64_and(Small64 a, Small64 b) { return a & b; }
+static inline Small64 small64_andnot(Small64 a, Small64 b) { return a & ~b; }
+static inline bool small64_empty(Small64 a) { return a == 0; }
+static inline int small64_count(Small64 a) { return _word_count(a); }
+static inline int small64_lowest(Small64 a) { return bitset_lowest_bit(a); }
+
+#define SMALL_WIDTH 64
+#include "small_search_template.h"
+#undef SMALL_WIDTH
+
+/* Sets of at most 128 nodes: two words, nodes 0-63 in `low` and nodes 64-127 in `high` */
+typedef struct {
+    uint64_t low;
+    uint64_t high;
+} Small128;
+
+static inline Small128 small128_none(void) { Small128 r = {0, 0}; return r; }
+static inline Small128 small128_bit(int i) {
+    Small128 r = {i < 64 ? (uint64_t)1 << i : 0, i < 64 ? 0 : (uint64_t)1 << (i - 64)};
+    return r;
+}
+static inline Small128 small128_or(Small128 a, Small128 b) { Small128 r = {a.low | b.low, a.high | b.high}; return r; }
+static inline Small128 small128_and(Small128 a, Small128 b) { Small128 r = {a.low & b.low, a.high & b.high}; return r; }
+static inline Small128 small128_andnot(Small128 a, Small128 b) { Small128 r = {a.low & ~b.low, a.high & ~b.high}; return r; }
+static inline bool small128_empty(Small128 a) { return (a.low | a.high) == 0; }
+static inline int small128_count(Small128 a) { return _word_count(a.low) + _word_count(a.high); }
+static inline int small128_lowest(Small128 a) { return a.low != 0 ? bitset_lowest_bit(a.low) : 64 + bitset_lowest_bit(a.high); }
+
+#define SMALL_WIDTH 128
+#include "small_search_template.h"
+#undef SMALL_WIDTH
+
+/**
+ * 1. Leaves the graphs to the general search when G1 is empty or too large, or an option beyond the signatures and the budget
+ *    of states is set.
+ * 2. Rejects the graphs with different sizes, degree sums or multisets of signatures (when requested), like vf2pp_init.
+ * 3. Computes the matching order of G1, or of its complement when the graphs are dense (see COMPLEMENT_MIN_DENSITY).
+ * 4. Runs the engine for one word up to 64 nodes, the one for two words otherwise.
+ */
+int small_isomorphic(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats) {
+    int n = G1->num_nodes;
+    if (n == 0 || n > SMALL_SEARCH_MAX_NODES) {
+        return -1;
+    }
+    if (options != NULL && (options->symmetry_breaking || options->nogoods || options->forward_checking || options->dynamic_order
+                            || options->all_different_period > 0 || options->arc_consistency
+                            || options->value_order != VALUE_ORDER_SCAN || options->endgame_threshold > 0
+                            || options->seed != 0 || options->restart_base > 0)) {
+        return -1;
+    }
+    VF2ppStats local_stats;
+    if (stats == NULL) {
+        stats = &local_stats;
+    }
+    vf2pp_clear_stats(stats);
+    if (G2->num_nodes != n) {
+        return 0;
+    }
+    long long degree_sum1 = 0, degree_sum2 = 0;
+    for (int i = 0; i < n; i++) {
+        degree_sum1 += G1->nodes[i].num_neighbors;
+        degree_sum2 += G2->nodes[i].num_neighbors;
+    }
+    if (degree_sum1 != degree_sum2) {
+        return 0;
+    }
+    if (options != NULL && options->signatures && !signatures_compatible(G1, G2)) {
+        return 0;
+    }
+
+    double possible_edges = (double)n * (n - 1) / 2;
+    bool complemented = degree_sum1 / 2 > COMPLEMENT_MIN_DENSITY * possible_edges;
+    int order[SMALL_SEARCH_MAX_NODES];
+    if (complemented) {
+        Graph* complement = complementGraph(G1);
+        if (complement == NULL) {
+            return -1;
+        }
+        matching_order(complement, order);
+        freeGraph(complement);
+    } else {
+        matching_order(G1, order);
+    }
+
+    bool signatures = G1->signature != NULL && G2->signature != NULL;
+    long max_states = (options != NULL) ? options->max_states : 0;
+    if (n <= 64) {
+        return small64_search(G1, G2, order, complemented, signatures, max_states, stats);
+    }
+    return small128_search(G1, G2, order, complemented, signatures, max_states, stats);
+}
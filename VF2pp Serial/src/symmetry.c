@@ -0,0 +1,472 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file symmetry.c
+ * @brief This file contains the functions used to detect the symmetries (automorphisms) of a graph and to break them during the search.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - symmetry.h: Definition of the symmetry data and of the forbidden pairs.
+ * - enumerate.h: Definition of the enumeration of all the mappings, used to search the automorphisms.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "vf2pp.h"
+#include "enumerate.h"
+#include "symmetry.h"
+
+/**
+ * Context of the automorphism search: the symmetry data being built and a union-find structure over the nodes,
+ * used to keep only the automorphisms that merge at least two orbits.
+ */
+typedef struct {
+    Symmetry* sym;
+    int* parent;
+    int max_generators;
+} AutomorphismSearch;
+
+/**
+ * Finds the representative of the set containing `x`, compressing the path.
+ */
+static int find_root(int* parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+/**
+ * Merges the sets containing `a` and `b`, keeping the smallest node as representative.
+ * Returns true if the two sets were different.
+ */
+static bool union_nodes(int* parent, int a, int b) {
+    int ra = find_root(parent, a);
+    int rb = find_root(parent, b);
+    if (ra == rb) {
+        return false;
+    }
+    if (ra < rb) {
+        parent[rb] = ra;
+    } else {
+        parent[ra] = rb;
+    }
+    return true;
+}
+
+/**
+ * Comparison function used by qsort to sort integers in ascending order.
+ */
+static int compare_int(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Computes a hash of a sorted list of nodes (FNV-1a on the node indexes).
+ */
+static unsigned long long hash_list(const int* list, int size) {
+    unsigned long long h = 1469598103934665603ULL;
+    for (int i = 0; i < size; i++) {
+        h ^= (unsigned long long)(unsigned int)list[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/**
+ * Context used by qsort to sort the nodes by neighborhood hash.
+ */
+typedef struct {
+    int node;
+    unsigned long long hash;
+} HashedNode;
+
+static int compare_hashed_node(const void* a, const void* b) {
+    const HashedNode* x = (const HashedNode*)a;
+    const HashedNode* y = (const HashedNode*)b;
+    if (x->hash != y->hash) {
+        return (x->hash > y->hash) - (x->hash < y->hash);
+    }
+    return x->node - y->node;
+}
+
+/**
+ * Groups the nodes whose (open or closed) neighborhoods are equal into twin classes.
+ * 1. For each node, builds the sorted neighborhood (adding the node itself for closed neighborhoods) and its hash.
+ * 2. Sorts the nodes by hash, so that twins are next to each other.
+ * 3. In each run of equal hashes, compares the neighborhoods to split hash collisions, and links the members of each class.
+ * Only nodes still alone in their class are considered, so a node belongs to at most one class.
+ */
+static void find_twins(Graph* g, Symmetry* sym, int** sorted, int* sizes, bool closed) {
+    int n = g->num_nodes;
+    HashedNode* hashed = (HashedNode*)malloc(n * sizeof(HashedNode));
+    int** lists = (int**)calloc(n, sizeof(int*));
+    int* lengths = (int*)calloc(n, sizeof(int));
+    int count = 0;
+
+    for (int u = 0; u < n; u++) {
+        if (sym->twin_class[u] != u || sym->twin_next[u] != -1) {
+            continue;
+        }
+        int* list = (int*)malloc((sizes[u] + 1) * sizeof(int));
+        int size = 0;
+        bool inserted = !closed;
+        for (int i = 0; i < sizes[u]; i++) {
+            if (!inserted && sorted[u][i] > u) {
+                list[size++] = u;
+                inserted = true;
+            }
+            list[size++] = sorted[u][i];
+        }
+        if (!inserted) {
+            list[size++] = u;
+        }
+        lists[u] = list;
+        lengths[u] = size;
+        hashed[count].node = u;
+        hashed[count].hash = hash_list(list, size);
+        count++;
+    }
+    qsort(hashed, count, sizeof(HashedNode), compare_hashed_node);
+
+    for (int start = 0; start < count; ) {
+        int end = start + 1;
+        while (end < count && hashed[end].hash == hashed[start].hash) {
+            end++;
+        }
+        for (int i = start; i < end; i++) {
+            int u = hashed[i].node;
+            if (sym->twin_class[u] != u) {
+                continue;
+            }
+            int last = u;
+            for (int j = i + 1; j < end; j++) {
+                int w = hashed[j].node;
+                if (sym->twin_class[w] == w && lengths[w] == lengths[u] &&
+                    memcmp(lists[u], lists[w], lengths[u] * sizeof(int)) == 0) {
+                    sym->twin_class[w] = u;
+                    sym->twin_next[last] = w;
+                    last = w;
+                }
+            }
+        }
+        start = end;
+    }
+
+    for (int u = 0; u < n; u++) {
+        free(lists[u]);
+    }
+    free(lists);
+    free(lengths);
+    free(hashed);
+}
+
+/**
+ * Callback of the automorphism search: stores the automorphism as a generator only if it merges at least two orbits,
+ * so the identity and the automorphisms already generated by the stored ones are discarded.
+ * Stops the search when `max_generators` generators have been stored.
+ */
+static bool collect_generator(const int* mapping, int num_nodes, void* user_data) {
+    AutomorphismSearch* search = (AutomorphismSearch*)user_data;
+    Symmetry* sym = search->sym;
+
+    bool useful = false;
+    for (int u = 0; u < num_nodes && !useful; u++) {
+        useful = find_root(search->parent, u) != find_root(search->parent, mapping[u]);
+    }
+    if (!useful) {
+        return true;
+    }
+
+    int* generator = (int*)malloc(num_nodes * sizeof(int));
+    if (generator == NULL) {
+        return false;
+    }
+    memcpy(generator, mapping, num_nodes * sizeof(int));
+    sym->generators[sym->num_generators++] = generator;
+    for (int u = 0; u < num_nodes; u++) {
+        union_nodes(search->parent, u, mapping[u]);
+    }
+    return sym->num_generators < search->max_generators;
+}
+
+/**
+ * Builds the symmetry data of a graph.
+ * 1. Sorts a copy of every neighborhood and finds the open twins, then the closed twins.
+ * 2. Merges the twin classes in the union-find structure of the orbits.
+ * 3. Runs a VF2++ enumeration of the graph against a copy of itself, limited to `max_states` states,
+ *    collecting at most `max_generators` automorphisms that enlarge the orbits.
+ * 4. Stores the orbit of each node as its smallest member.
+ */
+Symmetry* compute_symmetry(Graph* g, int max_generators, long max_states) {
+    int n = g->num_nodes;
+    Symmetry* sym = (Symmetry*)malloc(sizeof(Symmetry));
+    if (sym == NULL) {
+        fprintf(stderr, "ERROR: symmetry allocation error");
+        return NULL;
+    }
+    sym->num_nodes = n;
+    sym->twin_class = (int*)malloc(n * sizeof(int));
+    sym->twin_next = (int*)malloc(n * sizeof(int));
+    sym->orbit = (int*)malloc(n * sizeof(int));
+    sym->generators = (int**)malloc((max_generators > 0 ? max_generators : 1) * sizeof(int*));
+    sym->num_generators = 0;
+    sym->num_orbits = 0;
+    int* parent = (int*)malloc(n * sizeof(int));
+    int** sorted = (int**)malloc(n * sizeof(int*));
+    int* sizes = (int*)malloc(n * sizeof(int));
+    if (sym->twin_class == NULL || sym->twin_next == NULL || sym->orbit == NULL || sym->generators == NULL ||
+        parent == NULL || sorted == NULL || sizes == NULL) {
+        fprintf(stderr, "ERROR: symmetry allocation error");
+        free(parent);
+        free(sorted);
+        free(sizes);
+        free_symmetry(sym);
+        return NULL;
+    }
+
+    for (int u = 0; u < n; u++) {
+        sym->twin_class[u] = u;
+        sym->twin_next[u] = -1;
+        parent[u] = u;
+        sizes[u] = g->nodes[u].num_neighbors;
+        sorted[u] = (int*)malloc((sizes[u] > 0 ? sizes[u] : 1) * sizeof(int));
+        memcpy(sorted[u], g->nodes[u].neighborhood, sizes[u] * sizeof(int));
+        qsort(sorted[u], sizes[u], sizeof(int), compare_int);
+    }
+    find_twins(g, sym, sorted, sizes, false);
+    find_twins(g, sym, sorted, sizes, true);
+    for (int u = 0; u < n; u++) {
+        union_nodes(parent, u, sym->twin_class[u]);
+        free(sorted[u]);
+    }
+    free(sorted);
+    free(sizes);
+
+    if (max_generators > 0) {
+        Graph* copy = copyGraph(g);
+        AutomorphismSearch search;
+        search.sym = sym;
+        search.parent = parent;
+        search.max_generators = max_generators;
+
+        VF2ppOptions search_options;
+        vf2pp_default_options(&search_options);
+        search_options.max_states = max_states;
+
+        EnumerationOptions options;
+        options.max_mappings = 0;
+        options.count_only = false;
+        options.callback = collect_generator;
+        options.user_data = &search;
+        options.search = &search_options;
+        vf2pp_enumerate(g, copy, &options);
+        freeGraph(copy);
+    }
+
+    for (int u = 0; u < n; u++) {
+        sym->orbit[u] = find_root(parent, u);
+        if (sym->orbit[u] == u) {
+            sym->num_orbits++;
+        }
+    }
+    free(parent);
+    return sym;
+}
+
+/**
+ * Returns the symmetry data cached with the graph, computing them the first time.
+ */
+Symmetry* graph_symmetry(Graph* g) {
+    if (g->symmetry == NULL) {
+        g->symmetry = compute_symmetry(g, SYMMETRY_MAX_GENERATORS, SYMMETRY_MAX_STATES);
+    }
+    return g->symmetry;
+}
+
+/**
+ * Frees every generator and the arrays of the symmetry data.
+ */
+void free_symmetry(Symmetry* sym) {
+    if (sym == NULL) {
+        return;
+    }
+    if (sym->generators != NULL) {
+        for (int i = 0; i < sym->num_generators; i++) {
+            free(sym->generators[i]);
+        }
+    }
+    free(sym->generators);
+    free(sym->twin_class);
+    free(sym->twin_next);
+    free(sym->orbit);
+    free(sym);
+}
+
+/**
+ * Visits the nodes reachable from `node` through automorphisms that fix every mapped node of G1:
+ * 1. A twin transposition (x y) fixes the mapped nodes when x and y are both unmapped, so every unmapped twin of a visited node is reached.
+ * 2. A generator is usable only if it fixes every mapped node; the usable generators are applied to every visited node.
+ * The visit is a BFS that uses `orbit` itself as queue; `visited` is cleared before returning.
+ */
+int stabilizer_orbit(Symmetry* sym, Graph* G1, int node, int* orbit, bool* visited) {
+    int n = sym->num_nodes;
+    int usable[SYMMETRY_MAX_GENERATORS];
+    int num_usable = 0;
+    for (int i = 0; i < sym->num_generators && num_usable < SYMMETRY_MAX_GENERATORS; i++) {
+        int* generator = sym->generators[i];
+        bool fixes = true;
+        for (int u = 0; u < n && fixes; u++) {
+            if (G1->nodes[u].mapped != -1 && generator[u] != u) {
+                fixes = false;
+            }
+        }
+        if (fixes) {
+            usable[num_usable++] = i;
+        }
+    }
+    if (num_usable == 0 && sym->twin_class[node] == node && sym->twin_next[node] == -1) {
+        return 0;
+    }
+
+    int size = 0;
+    orbit[size++] = node;
+    visited[node] = true;
+    for (int head = 0; head < size; head++) {
+        int x = orbit[head];
+        for (int y = sym->twin_class[x]; y != -1; y = sym->twin_next[y]) {
+            if (!visited[y] && G1->nodes[y].mapped == -1) {
+                visited[y] = true;
+                orbit[size++] = y;
+            }
+        }
+        for (int i = 0; i < num_usable; i++) {
+            int y = sym->generators[usable[i]][x];
+            if (!visited[y]) {
+                visited[y] = true;
+                orbit[size++] = y;
+            }
+        }
+    }
+
+    for (int i = 0; i < size; i++) {
+        visited[orbit[i]] = false;
+    }
+    /* Remove `node` itself, which is the first element */
+    for (int i = 1; i < size; i++) {
+        orbit[i - 1] = orbit[i];
+    }
+    return size - 1;
+}
+
+/**
+ * Allocates the head of every node (no pairs) and an initial pool of pairs.
+ */
+void init_forbidden_pairs(ForbiddenPairs* pairs, int num_nodes) {
+    pairs->head = (int*)malloc(num_nodes * sizeof(int));
+    pairs->capacity = 64;
+    pairs->size = 0;
+    pairs->node = (int*)malloc(pairs->capacity * sizeof(int));
+    pairs->value = (int*)malloc(pairs->capacity * sizeof(int));
+    pairs->depth = (int*)malloc(pairs->capacity * sizeof(int));
+    pairs->next = (int*)malloc(pairs->capacity * sizeof(int));
+    if (pairs->head == NULL || pairs->node == NULL || pairs->value == NULL || pairs->depth == NULL || pairs->next == NULL) {
+        fprintf(stderr, "ERROR: forbidden pairs allocation error");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < num_nodes; i++) {
+        pairs->head[i] = -1;
+    }
+}
+
+/**
+ * Pushes the pair on the stack, doubling the capacity when it is full, and links it to the previous pair of the same node.
+ */
+void add_forbidden_pair(ForbiddenPairs* pairs, int node, int value, int depth) {
+    if (pairs->size == pairs->capacity) {
+        int capacity = pairs->capacity * 2;
+        int* new_node = (int*)realloc(pairs->node, capacity * sizeof(int));
+        if (new_node != NULL) pairs->node = new_node;
+        int* new_value = (int*)realloc(pairs->value, capacity * sizeof(int));
+        if (new_value != NULL) pairs->value = new_value;
+        int* new_depth = (int*)realloc(pairs->depth, capacity * sizeof(int));
+        if (new_depth != NULL) pairs->depth = new_depth;
+        int* new_next = (int*)realloc(pairs->next, capacity * sizeof(int));
+        if (new_next != NULL) pairs->next = new_next;
+        if (new_node == NULL || new_value == NULL || new_depth == NULL || new_next == NULL) {
+            fprintf(stderr, "ERROR: forbidden pairs resizing error");
+            exit(EXIT_FAILURE);
+        }
+        pairs->capacity = capacity;
+    }
+    int index = pairs->size++;
+    pairs->node[index] = node;
+    pairs->value[index] = value;
+    pairs->depth[index] = depth;
+    pairs->next[index] = pairs->head[node];
+    pairs->head[node] = index;
+}
+
+/**
+ * Scans the pairs of the node, from the most recent one.
+ */
+bool is_forbidden_pair(ForbiddenPairs* pairs, int node, int value) {
+    for (int i = pairs->head[node]; i != -1; i = pairs->next[i]) {
+        if (pairs->value[i] == value) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Pops the pairs from the top of the stack while they belong to a depth greater than or equal to `depth`:
+ * since deeper nodes are always removed first, these pairs are all on the top.
+ */
+void backtrack_forbidden_pairs(ForbiddenPairs* pairs, int depth) {
+    while (pairs->size > 0 && pairs->depth[pairs->size - 1] >= depth) {
+        int index = --pairs->size;
+        pairs->head[pairs->node[index]] = pairs->next[index];
+    }
+}
+
+/**
+ * Frees every array of the set.
+ */
+void free_forbidden_pairs(ForbiddenPairs* pairs) {
+    free(pairs->head);
+    free(pairs->node);
+    free(pairs->value);
+    free(pairs->depth);
+    free(pairs->next);
+}
@@ -0,0 +1,236 @@
+/* 
+ * Course: High Performance Computing 2023/2024
+ * 
+ * Lecturer: Francesco Moscato	fmoscato@unisa.it
+ *
+ * Student:
+ * Pepe Lorenzo        0622702121      l.pepe29@studenti.unisa.it          
+ * 
+ *
+ *               REQUIREMENTS OF THE ASSIGNMENT:
+ * Design, Implement, and Analyze a parallel version of VF2-pp based on MPI
+ *
+ *
+ * Copyright (C) 2024 - All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of 
+ * the GNU General Public License as published by the Free Software Foundation, either version 
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; 
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with ContestOMP. 
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+/**
+ *
+ * @file value_order.c
+ * @brief This file contains the functions that rank the candidates of a node according to the value ordering strategies.
+ * 
+ * @dependencies
+ * This module depends on the following files:
+ * - graph.h: Definition of graph structure.
+ * - value_order.h: Defines the strategies and their ranks.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "graph.h"
+#include "value_order.h"
+
+static const char* STRATEGY_NAMES[] = {"scan", "rarest", "unmapped", "learned", "random"};
+#define NUM_STRATEGIES ((int)(sizeof(STRATEGY_NAMES) / sizeof(STRATEGY_NAMES[0])))
+
+/**
+ * Scrambles a 64-bit value (the finalizer of splitmix64), so that the sum of the scrambled keys of the neighbors is a hash of
+ * their multiset.
+ */
+static uint64_t _mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * Computes the refined class of every node of a graph: its key combined with the sum of the scrambled keys of its neighbors,
+ * which does not depend on the order of the neighbor list. The key is the one that the candidates share (see find_candidates.h).
+ */
+static void _refined_classes(Graph* g, bool signatures, uint64_t* classes) {
+    for (int x = 0; x < g->num_nodes; x++) {
+        uint64_t sum = 0;
+        for (int i = 0; i < g->nodes[x].num_neighbors; i++) {
+            int w = g->nodes[x].neighborhood[i];
+            sum += _mix(signatures ? g->signature[w] : (uint64_t)g->nodes[w].num_neighbors);
+        }
+        uint64_t key = signatures ? g->signature[x] : (uint64_t)g->nodes[x].num_neighbors;
+        classes[x] = _mix(key ^ _mix(sum));
+    }
+}
+
+static int _compare_classes(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Returns the first position of a sorted array whose value is not below `value` (above it, when `above` is true).
+ */
+static int _bound(const uint64_t* sorted, int n, uint64_t value, bool above) {
+    int lo = 0;
+    int hi = n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (sorted[mid] < value || (above && sorted[mid] == value)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Computes the refined classes of both graphs and the size of the class of every node of G2, counted with two binary searches
+ * in a sorted copy of the classes.
+ */
+static bool _init_rarest(ValueRanks* ranks, Graph* G1, Graph* G2) {
+    int n = G2->num_nodes;
+    bool signatures = G1->signature != NULL && G2->signature != NULL;
+    ranks->class1 = (uint64_t*)malloc(G1->num_nodes * sizeof(uint64_t));
+    ranks->class2 = (uint64_t*)malloc(n * sizeof(uint64_t));
+    ranks->class_size = (int*)malloc(n * sizeof(int));
+    uint64_t* sorted = (uint64_t*)malloc(n * sizeof(uint64_t));
+    if (ranks->class1 == NULL || ranks->class2 == NULL || ranks->class_size == NULL || sorted == NULL) {
+        free(sorted);
+        return false;
+    }
+    _refined_classes(G1, signatures, ranks->class1);
+    _refined_classes(G2, signatures, ranks->class2);
+    memcpy(sorted, ranks->class2, n * sizeof(uint64_t));
+    qsort(sorted, n, sizeof(uint64_t), _compare_classes);
+    for (int v = 0; v < n; v++) {
+        ranks->class_size[v] = _bound(sorted, n, ranks->class2[v], true) - _bound(sorted, n, ranks->class2[v], false);
+    }
+    free(sorted);
+    return true;
+}
+
+/**
+ * Copies the hint, leaving out the images that are not nodes of G2. The hint is refused when it has not a value for every node
+ * of G1, or when none of its images is usable.
+ */
+static bool _init_learned(ValueRanks* ranks, Graph* G1, Graph* G2, const int* hint, int hint_nodes) {
+    int n = G1->num_nodes;
+    if (hint == NULL || hint_nodes != n) {
+        return false;
+    }
+    ranks->hint = (int*)malloc(n * sizeof(int));
+    if (ranks->hint == NULL) {
+        return false;
+    }
+    bool usable = false;
+    for (int u = 0; u < n; u++) {
+        bool valid = hint[u] >= 0 && hint[u] < G2->num_nodes;
+        ranks->hint[u] = valid ? hint[u] : -1;
+        usable = usable || valid;
+    }
+    return usable;
+}
+
+/**
+ * Prepares the data of the strategy: the refined classes for VALUE_ORDER_RAREST, a copy of the hint for VALUE_ORDER_LEARNED;
+ * VALUE_ORDER_UNMAPPED reads only the current mapping, and VALUE_ORDER_RANDOM only the seed.
+ */
+bool init_value_ranks(ValueRanks* ranks, int strategy, Graph* G1, Graph* G2, const int* hint, int hint_nodes, uint64_t seed) {
+    memset(ranks, 0, sizeof(ValueRanks));
+    ranks->strategy = strategy;
+    ranks->seed = seed;
+    bool ok = false;
+    if (strategy == VALUE_ORDER_RAREST) {
+        ok = _init_rarest(ranks, G1, G2);
+    } else if (strategy == VALUE_ORDER_UNMAPPED || strategy == VALUE_ORDER_RANDOM) {
+        ok = true;
+    } else if (strategy == VALUE_ORDER_LEARNED) {
+        ok = _init_learned(ranks, G1, G2, hint, hint_nodes);
+    }
+    if (!ok) {
+        free_value_ranks(ranks);
+    }
+    return ok;
+}
+
+/**
+ * Frees every array of the ranks.
+ */
+void free_value_ranks(ValueRanks* ranks) {
+    free(ranks->class1);
+    free(ranks->class2);
+    free(ranks->class_size);
+    free(ranks->hint);
+    memset(ranks, 0, sizeof(ValueRanks));
+}
+
+/**
+ * Counts the unmapped nodes at distance two of x, once for every path of length two that reaches them: the sum, over the
+ * neighbors of x, of their unmapped neighbors.
+ */
+static long _unmapped_at_distance_two(Graph* g, int x) {
+    long count = 0;
+    for (int i = 0; i < g->nodes[x].num_neighbors; i++) {
+        Node* w = &g->nodes[g->nodes[x].neighborhood[i]];
+        for (int j = 0; j < w->num_neighbors; j++) {
+            count += (g->nodes[w->neighborhood[j]].mapped == -1);
+        }
+    }
+    return count;
+}
+
+/**
+ * Ranks v by the count of the strategy, below `bound` for every candidate; the candidates whose count differs from the one of u
+ * cannot be its image in this mapping, so `bound` is added to their rank to try them last.
+ *  - VALUE_ORDER_RAREST: the size of the refined class of v, against the refined class of u (bound: the nodes of G2).
+ *  - VALUE_ORDER_UNMAPPED: the unmapped nodes at distance two of v (_unmapped_at_distance_two), against the ones of u (bound: the
+ *    square of the nodes of G2).
+ *  - VALUE_ORDER_LEARNED: 0 for the image of u in the hint, 1 for the other candidates.
+ *  - VALUE_ORDER_RANDOM: a hash of the seed and the pair, without a bound: every candidate may be the image of u.
+ */
+long candidate_rank(const ValueRanks* ranks, Graph* G1, Graph* G2, int u, int v) {
+    long n = G2->num_nodes;
+    if (ranks->strategy == VALUE_ORDER_RAREST) {
+        return ranks->class_size[v] + ((ranks->class1[u] == ranks->class2[v]) ? 0 : n);
+    }
+    if (ranks->strategy == VALUE_ORDER_UNMAPPED) {
+        long count = _unmapped_at_distance_two(G2, v);
+        return count + ((count == _unmapped_at_distance_two(G1, u)) ? 0 : n * n);
+    }
+    if (ranks->strategy == VALUE_ORDER_LEARNED) {
+        return (ranks->hint[u] == v) ? 0 : 1;
+    }
+    if (ranks->strategy == VALUE_ORDER_RANDOM) {
+        return (long)(_mix(ranks->seed ^ _mix(((uint64_t)(uint32_t)u << 32) | (uint32_t)v)) >> 1);
+    }
+    return 0;
+}
+
+/**
+ * Returns the name of the strategy in STRATEGY_NAMES.
+ */
+const char* value_order_name(int strategy) {
+    return (strategy >= 0 && strategy < NUM_STRATEGIES) ? STRATEGY_NAMES[strategy] : "unknown";
+}
+
+/**
+ * Looks up the name in STRATEGY_NAMES.
+ */
+int value_order_from_name(const char* name) {
+    for (int strategy = 0; strategy < NUM_STRATEGIES; strategy++) {
+        if (strcmp(name, STRATEGY_NAMES[strategy]) == 0) {
+            return strategy;
+        }
+    }
+    return -1;
+}
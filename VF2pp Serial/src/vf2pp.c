@@ -34,7 +34,18 @@
  * - graph.h: Definition of graph structure.
  * - node_ordering.h: Definition of the data structures and functions useful for performing graph node sorting operations.
  * - find_candidates.h: Definition of the functions to find nodes of G2 that are candidates to be mapped to a node of G1.
+ * - bitset.h: Definition of the bitsets of the frontier.
  * - stack.h: Definition of the data structures and functions to manage the stack that stores a node's candidates in order to keep track of mappings.
+ * - signature.h: Definition of the structural signatures of the nodes.
+ * - heap_counter.h: Definition of the counter of the heap calls, used to check that the search loop does not allocate memory.
+ * - backjump.h: Definition of the conflict sets used to backjump.
+ * - nogood.h: Definition of the table of failed subproblems.
+ * - domains.h: Definition of the domains narrowed by forward checking.
+ * - dynamic_order.h: Definition of the keys used to choose the next node dynamically.
+ * - all_different.h: Definition of the all-different propagator.
+ * - arc_consistency.h: Definition of the filtering of the initial domains.
+ * - small_search.h: Definition of the search specialized for small graphs.
+ * - canonical.h: Definition of the canonical certificates that decide the stalled searches.
  * - vf2pp.h: Definition of the main functions used to check whether two graphs are isomorphic.
  */
 
@@ -45,183 +56,1096 @@
 #include "graph.h"
 #include "node_ordering.h"
 #include "find_candidates.h"
+#include "bitset.h"
 #include "stack.h"
+#include "signature.h"
+#include "heap_counter.h"
+#include "backjump.h"
+#include "nogood.h"
+#include "domains.h"
+#include "dynamic_order.h"
+#include "all_different.h"
+#include "arc_consistency.h"
+#include "components.h"
+#include "forest.h"
+#include "core.h"
+#include "twins.h"
+#include "small_search.h"
+#include "canonical.h"
 #include "vf2pp.h"
 
 /**
- * Restores the state of the Boolean vector T2_tilde when a previously mapped node is removed from the match.
- * This function handles the neighbors of the removed node (popped_node2) and updates T2_tilde to correctly reflect the availability of neighbor nodes for further matching.
- *  1. Iterates over all neighbors of the popped_node2 node in the G2 graph.
- *  2. For each neighbor:
- *      If the neighbor has an active match (mapping != -1), set an is_added flag to true.
- *      Otherwise, check whether the neighbors of the neighbor have a match. If none of these neighbors are mapped, mark the neighbor node as unavailable in T2_tilde.
- *  3. If none of the neighbors are mapped, re-add popped_node2 to T2_tilde, making it available for subsequent matches.
- */
-void _restore_Tinout(Graph* G2, int popped_node2, bool* T2_tilde) {
-    bool is_added = false; bool exit = false;
-    for (int i = 0; i < G2->nodes[popped_node2].num_neighbors; i++) {
-        int nbr = G2->nodes[popped_node2].neighborhood[i];
-        if(G2->nodes[nbr].mapped != -1){
-            is_added = true;
-        }
-        else {
-            for (int j = 0; j <G2->nodes[nbr].num_neighbors; j++) {
-                int nbr2 = G2->nodes[nbr].neighborhood[j];
-                if ((G2->nodes[nbr2].mapped != -1)) {
-                    exit = true;
-                    break;
+ * Allocates the bitsets of the frontier and the trails, with every node in T1_tilde/T2_tilde.
+ * The adjacency bitsets of the graphs are used when requested and available; otherwise the frontier falls back to the neighbor lists.
+ */
+bool init_frontier(Frontier* frontier, Graph* G1, Graph* G2, bool use_adjacency) {
+    int n = G1->num_nodes;
+    memset(frontier, 0, sizeof(Frontier));
+    frontier->words = bitset_words(n);
+    if (use_adjacency) {
+        frontier->adjacency1 = graph_adjacency(G1);
+        frontier->adjacency2 = graph_adjacency(G2);
+        if (frontier->adjacency1 == NULL || frontier->adjacency2 == NULL) {
+            frontier->adjacency1 = NULL;
+            frontier->adjacency2 = NULL;
+        }
+    }
+    frontier->mapped1 = bitset_alloc(n);
+    frontier->mapped2 = bitset_alloc(n);
+    frontier->T1 = bitset_alloc(n);
+    frontier->T2 = bitset_alloc(n);
+    frontier->T1_tilde = bitset_alloc(n);
+    frontier->T2_tilde = bitset_alloc(n);
+    frontier->trail1 = (int*)malloc(n * sizeof(int));
+    frontier->trail2 = (int*)malloc(n * sizeof(int));
+    frontier->levels = (FrontierLevel*)malloc(n * sizeof(FrontierLevel));
+    if (frontier->mapped1 == NULL || frontier->mapped2 == NULL || frontier->T1 == NULL || frontier->T2 == NULL ||
+        frontier->T1_tilde == NULL || frontier->T2_tilde == NULL || frontier->trail1 == NULL || frontier->trail2 == NULL || frontier->levels == NULL) {
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        bitset_set(frontier->T1_tilde, i);
+        bitset_set(frontier->T2_tilde, i);
+    }
+    return true;
+}
+
+/**
+ * Frees the bitsets and the trails owned by the frontier.
+ */
+void free_frontier(Frontier* frontier) {
+    free(frontier->mapped1);
+    free(frontier->mapped2);
+    free(frontier->T1);
+    free(frontier->T2);
+    free(frontier->T1_tilde);
+    free(frontier->T2_tilde);
+    free(frontier->trail1);
+    free(frontier->trail2);
+    free(frontier->levels);
+    memset(frontier, 0, sizeof(Frontier));
+}
+
+/**
+ * Adds `node` to the mapped nodes of one graph and its unmapped neighbors to T, returning true if the node was in T.
+ * With the adjacency bitsets, each word of the neighbors added is `row & ~(T | mapped)`: it is ORed into T, cleared from T_tilde
+ * and its bits are pushed on the trail. Without them, the same is done one neighbor at a time.
+ */
+static bool _map_node(Graph* G, const uint64_t* adjacency, int words, int node, uint64_t* mapped, uint64_t* T, uint64_t* T_tilde, int* trail, int* trail_size) {
+    bool in_T = bitset_test(T, node);
+    bitset_clear(T, node);
+    bitset_clear(T_tilde, node);
+    bitset_set(mapped, node);
+    if (adjacency != NULL) {
+        const uint64_t* row = adjacency + (size_t)node * words;
+        for (int i = 0; i < words; i++) {
+            uint64_t added = row[i] & ~(T[i] | mapped[i]);
+            if (added == 0) {
+                continue;
+            }
+            T[i] |= added;
+            T_tilde[i] &= ~added;
+            for (; added != 0; added &= added - 1) {
+                trail[(*trail_size)++] = i * BITSET_WORD_BITS + bitset_lowest_bit(added);
+            }
+        }
+    } else {
+        for (int i = 0; i < G->nodes[node].num_neighbors; i++) {
+            int nbr = G->nodes[node].neighborhood[i];
+            if (!bitset_test(mapped, nbr) && !bitset_test(T, nbr)) {
+                bitset_set(T, nbr);
+                bitset_clear(T_tilde, nbr);
+                trail[(*trail_size)++] = nbr;
+            }
+        }
+    }
+    return in_T;
+}
+
+/**
+ * Undoes _map_node: the nodes pushed on the trail since `trail_start` go back from T to T_tilde, then `node` is unmapped
+ * and put back in T or T_tilde.
+ */
+static void _unmap_node(int node, bool in_T, int trail_start, uint64_t* mapped, uint64_t* T, uint64_t* T_tilde, const int* trail, int* trail_size) {
+    while (*trail_size > trail_start) {
+        int nbr = trail[--(*trail_size)];
+        bitset_clear(T, nbr);
+        bitset_set(T_tilde, nbr);
+    }
+    bitset_clear(mapped, node);
+    bitset_set(in_T ? T : T_tilde, node);
+}
+
+/**
+ * Counts the neighbors of `node` in `set`: popcount of the intersection with its adjacency bitset, or a scan of its neighbor list.
+ */
+static int _count_neighbors_in(Graph* G, const uint64_t* adjacency, int words, int node, const uint64_t* set) {
+    if (adjacency != NULL) {
+        return bitset_and_count(adjacency + (size_t)node * words, set, words);
+    }
+    int count = 0;
+    for (int i = 0; i < G->nodes[node].num_neighbors; i++) {
+        count += bitset_test(set, G->nodes[node].neighborhood[i]);
+    }
+    return count;
+}
+
+/**
+ * Updates the frontier when the pair (popped_node1, popped_node2), the last one added, is removed from the match.
+ * The level of the pair tells which nodes entered T1 and T2 with it: they go back to T1_tilde and T2_tilde, so the update costs
+ * as much as the nodes moved, without rescanning any neighborhood.
+ */
+void _restore_Tinout(Graph* G1, Graph* G2, int popped_node1, int popped_node2, Frontier* frontier) {
+    (void)G1;
+    (void)G2;
+    FrontierLevel* level = &frontier->levels[--frontier->depth];
+    _unmap_node(popped_node1, level->in_T1, level->trail1_start, frontier->mapped1, frontier->T1, frontier->T1_tilde, frontier->trail1, &frontier->trail1_size);
+    _unmap_node(popped_node2, level->in_T2, level->trail2_start, frontier->mapped2, frontier->T2, frontier->T2_tilde, frontier->trail2, &frontier->trail2_size);
+}
+
+/**
+ * Updates the frontier to reflect the new mapping of the pair (new_node1, new_node2).
+ *  1. Records the sizes of the trails and whether the two nodes were in T1/T2, in the level of the current depth.
+ *  2. Moves the two nodes to the mapped ones and their unmapped neighbors to T1/T2 (_map_node).
+ */
+void _update_Tinout(Graph* G1, Graph* G2, int new_node1, int new_node2, Frontier* frontier) {
+    FrontierLevel* level = &frontier->levels[frontier->depth++];
+    level->trail1_start = frontier->trail1_size;
+    level->trail2_start = frontier->trail2_size;
+    level->in_T1 = _map_node(G1, frontier->adjacency1, frontier->words, new_node1, frontier->mapped1, frontier->T1, frontier->T1_tilde, frontier->trail1, &frontier->trail1_size);
+    level->in_T2 = _map_node(G2, frontier->adjacency2, frontier->words, new_node2, frontier->mapped2, frontier->T2, frontier->T2_tilde, frontier->trail2, &frontier->trail2_size);
+}
+
+/* Reasons why _cut_reason rejects a pair */
+#define CUT_NONE 0
+#define CUT_CONSISTENCY 1
+#define CUT_MORE_IN_T 2
+#define CUT_FEWER_IN_T 3
+
+/**
+ * Checks whether the pair (u, v) can extend the current mapping, counting neighbors with the bitsets of the frontier, and returns
+ * the reason of the rejection (CUT_NONE if the pair is accepted).
+ *  1. Consistency: the candidates of u are adjacent to the images of all the mapped neighbors of u, so the pair is consistent
+ *     only if v has no other mapped neighbor, i.e. if u and v have the same number of mapped neighbors.
+ *  2. Cut rule: u and v must have the same number of neighbors in T1 and T2. Since u and v have the same degree and the same
+ *     number of mapped neighbors, this also gives the same number of neighbors in T1_tilde and T2_tilde.
+ */
+static int _cut_reason(Graph* G1, Graph* G2, int u, int v, Frontier* frontier) {
+    int words = frontier->words;
+    if (_count_neighbors_in(G1, frontier->adjacency1, words, u, frontier->mapped1) != _count_neighbors_in(G2, frontier->adjacency2, words, v, frontier->mapped2)) {
+        return CUT_CONSISTENCY;
+    }
+    int count1 = _count_neighbors_in(G1, frontier->adjacency1, words, u, frontier->T1);
+    int count2 = _count_neighbors_in(G2, frontier->adjacency2, words, v, frontier->T2);
+    if (count1 == count2) {
+        return CUT_NONE;
+    }
+    return (count2 > count1) ? CUT_MORE_IN_T : CUT_FEWER_IN_T;
+}
+
+/**
+ * Checks whether the pair (u, v) can extend the current mapping (_cut_reason).
+ */
+bool _cut_PT(Graph* G1, Graph* G2, int u, int v, Frontier* frontier) {
+    return _cut_reason(G1, G2, u, v, frontier) != CUT_NONE;
+}
+
+/**
+ * Records the depth of the pair just mapped as the entry depth of the nodes of G2 that it added to T2 (the last part of trail2).
+ */
+static void _record_entries(VF2ppState* state, int depth) {
+    Frontier* frontier = &state->frontier;
+    for (int i = frontier->levels[depth].trail2_start; i < frontier->trail2_size; i++) {
+        state->conflicts.entered[frontier->trail2[i]] = depth;
+    }
+}
+
+/**
+ * Adds an earlier depth to the conflict set of `depth`; the depth itself is skipped, since it is the pair being rejected when
+ * u has been left without candidates by the pair just mapped at `depth` (forward checking).
+ */
+static inline void _add_culprit(ConflictSets* conflicts, int depth, int culprit) {
+    if (culprit < depth) {
+        add_conflict(conflicts, depth, culprit);
+    }
+}
+
+/**
+ * Adds to the conflict set of `depth` the reasons why the nodes of G2 with the key of u were not candidates of u; the nodes with
+ * another key are never candidates, whatever the mapping.
+ *  1. The depths of the mapped neighbors of u: a node that is not adjacent to the image of one of them is not a candidate.
+ *  2. Without mapped neighbors, the candidates are in T2_tilde: a mapped node is excluded by the depth of its preimage, a node of
+ *     T2 by the depth that added it to T2 (it keeps a mapped neighbor, while u has none).
+ *     With mapped neighbors, the excluded nodes adjacent to all their images are mapped: they are among the mapped neighbors of
+ *     the first image, excluded by the depths of their preimages.
+ *  3. With the all-different propagator, the nodes it removed from the domain of u: every depth up to the deepest one that
+ *     removed candidates.
+ */
+static void _explain_candidates(VF2ppState* state, int depth, int u) {
+    Frontier* frontier = &state->frontier;
+    ConflictSets* conflicts = &state->conflicts;
+    int words = frontier->words;
+    if (state->use_all_different && pruned_below(&state->all_different, depth) != -1) {
+        add_conflict_prefix(conflicts, depth, pruned_below(&state->all_different, depth));
+    }
+    int node_class = state->filter.node_class[u];
+    if (node_class == -1) {
+        return;
+    }
+    const uint64_t* class_bits = state->filter.class_bits + (size_t)node_class * words;
+    const uint64_t* row1 = frontier->adjacency1 + (size_t)u * words;
+    int first = -1;
+    for (int i = 0; i < words; i++) {
+        for (uint64_t word = row1[i] & frontier->mapped1[i]; word != 0; word &= word - 1) {
+            int w = i * BITSET_WORD_BITS + bitset_lowest_bit(word);
+            _add_culprit(conflicts, depth, conflicts->depth_of[w]);
+            if (first == -1) {
+                first = w;
+            }
+        }
+    }
+    if (first == -1) {
+        for (int i = 0; i < words; i++) {
+            for (uint64_t word = class_bits[i] & (frontier->mapped2[i] | frontier->T2[i]); word != 0; word &= word - 1) {
+                int x = i * BITSET_WORD_BITS + bitset_lowest_bit(word);
+                int culprit = bitset_test(frontier->mapped2, x) ? conflicts->depth_of[state->G2->nodes[x].mapped] : conflicts->entered[x];
+                _add_culprit(conflicts, depth, culprit);
+            }
+        }
+        return;
+    }
+    const uint64_t* row2 = frontier->adjacency2 + (size_t)state->G1->nodes[first].mapped * words;
+    for (int i = 0; i < words; i++) {
+        for (uint64_t word = class_bits[i] & row2[i] & frontier->mapped2[i]; word != 0; word &= word - 1) {
+            int x = i * BITSET_WORD_BITS + bitset_lowest_bit(word);
+            _add_culprit(conflicts, depth, conflicts->depth_of[state->G2->nodes[x].mapped]);
+        }
+    }
+}
+
+/**
+ * Adds to the conflict set of `depth` the reason why _cut_reason rejected the candidate v of u. The mapped neighbors of u, which
+ * are always in the set when a depth fails (_explain_candidates), are mapped to neighbors of v.
+ *  1. Consistency: v has more mapped neighbors than u; the depths of the preimages that are not neighbors of u are the reason.
+ *  2. Cut rule, v with more neighbors in T2 than u in T1: the set of mapped nodes of G1 depends only on the depth, so the count of u
+ *     is fixed, while the count of v can only grow (or v gets a new mapped neighbor) as long as the nodes of T2 keep a mapped
+ *     neighbor. The depths that added to T2 the first count + 1 neighbors of v are the reason.
+ *  3. Cut rule, v with fewer neighbors in T2: any other assignment could add the missing ones, so every earlier depth is in the set.
+ *     With the dynamic order the mapped nodes of G1 depend on the earlier assignments too, so the same holds for case 2.
+ */
+static void _explain_rejection(VF2ppState* state, int depth, int u, int v, int reason) {
+    Frontier* frontier = &state->frontier;
+    ConflictSets* conflicts = &state->conflicts;
+    int words = frontier->words;
+    const uint64_t* row1 = frontier->adjacency1 + (size_t)u * words;
+    const uint64_t* row2 = frontier->adjacency2 + (size_t)v * words;
+    if (reason == CUT_FEWER_IN_T || (reason == CUT_MORE_IN_T && state->dynamic)) {
+        add_all_conflicts(conflicts, depth);
+    } else if (reason == CUT_CONSISTENCY) {
+        for (int i = 0; i < words; i++) {
+            for (uint64_t word = row2[i] & frontier->mapped2[i]; word != 0; word &= word - 1) {
+                int w = state->G2->nodes[i * BITSET_WORD_BITS + bitset_lowest_bit(word)].mapped;
+                if (!bitset_test(row1, w)) {
+                    add_conflict(conflicts, depth, conflicts->depth_of[w]);
                 }
             }
-            if(exit){
-                exit = false;
-                continue;
+        }
+    } else {
+        int count1 = bitset_and_count(row1, frontier->T1, words);
+        int* entries = conflicts->scratch;
+        int num_entries = 0;
+        for (int i = 0; i < words; i++) {
+            for (uint64_t word = row2[i] & frontier->T2[i]; word != 0; word &= word - 1) {
+                entries[num_entries++] = conflicts->entered[i * BITSET_WORD_BITS + bitset_lowest_bit(word)];
             }
-            else{
-                T2_tilde[nbr] = false;
+        }
+        for (int k = 0; k <= count1; k++) {
+            int smallest = k;
+            for (int i = k + 1; i < num_entries; i++) {
+                if (entries[i] < entries[smallest]) {
+                    smallest = i;
+                }
             }
+            int entry = entries[smallest];
+            entries[smallest] = entries[k];
+            entries[k] = entry;
+            add_conflict(conflicts, depth, entry);
         }
     }
-    if(!is_added){
-        T2_tilde[popped_node2] = true;
+}
+
+/**
+ * Removes the pair of the node at the top of the stack from the mapping, restoring the frontier and the domains.
+ */
+static void _unmap_top(VF2ppState* state) {
+    int node1 = state->stack.elements[state->stack.top].node;
+    int node2 = state->G1->nodes[node1].mapped;
+    state->G1->nodes[node1].mapped = -1;
+    state->G2->nodes[node2].mapped = -1;
+    state->num_mapping -= 1;
+    _restore_Tinout(state->G1, state->G2, node1, node2, &state->frontier);
+    if (state->use_domains) {
+        restore_domains(&state->domains, state->G1, &state->filter, state->frontier.adjacency2, node1, state->frontier.T1, state->frontier.T2, state->dynamic ? &state->order : NULL);
     }
 }
 
 /**
- * Update vector T2_tilde to reflect the new mapping of node new_node2. 
- * Once mapped, this node and its direct neighbors become unavailable for further matches. 
- * 1. Iterate on all neighbors of new_node2 in G2. 
- * 2. Set T2_tilde to false for each neighbor, making them unavailable. 
- * 3. Also mark new_node2 as unavailable by setting T2_tilde[new_node2] = false.
+ * Prepares the stack element of the next node to be matched: the next one of node_order or, with the dynamic order, the unmapped
+ * node with the fewest candidates. No candidate is computed yet: the element only records how they will be scanned (the pivot),
+ * unless they are scanned in the domain of the node.
+ */
+static NodeCandidates _next_node(VF2ppState* state) {
+    NodeCandidates node;
+    node.node = state->dynamic ? select_node(&state->order) : state->node_order[state->matching_node];
+    node.pivot = state->use_domains ? PIVOT_NONE : candidate_pivot(node.node, state->G1, state->G2, state->use_filter ? &state->filter : NULL);
+    node.cursor = 0;
+    node.rank = -1;
+    return node;
+}
+
+/**
+ * Returns the candidate of a stack element found after `cursor` in the scan of its candidates, and moves `cursor` past it; -1
+ * when the scan is over.
+ * The candidate is found only now (next_candidate), from the pivot of the element: the frontier and the mapped neighbors of the
+ * node are the same as when the element was pushed, since the deeper depths have been undone.
+ * With the domains the cursor is a node of G2: the candidates are the nodes of the domain in T2, or in T2_tilde when the node has
+ * no mapped neighbor, from the cursor on.
  */
-void _update_Tinout(Graph* G2, int new_node2, bool* T2_tilde) {
-    for(int i=0; i<G2->nodes[new_node2].num_neighbors; i++){
-        int nbr = G2->nodes[new_node2].neighborhood[i];
-        T2_tilde[nbr] = false;
+static int _scan_candidate(VF2ppState* state, const NodeCandidates* element, int* cursor) {
+    const Frontier* frontier = &state->frontier;
+    if (!state->use_domains) {
+        return next_candidate(element->node, element->pivot, cursor, state->G1, state->G2, frontier->T2, frontier->T2_tilde, state->use_filter ? &state->filter : NULL);
     }
-    T2_tilde[new_node2] = false;
+    const uint64_t* pool = bitset_test(frontier->T1, element->node) ? frontier->T2 : frontier->T2_tilde;
+    int candidate = next_domain_candidate(&state->domains, element->node, pool, *cursor);
+    *cursor = (candidate == -1) ? state->G1->num_nodes : candidate + 1;
+    return candidate;
 }
 
 /**
- * Implements the VF2++ algorithm to check whether two graphs G1 and G2 are isomorphic. 
- * Returns true if there is a biunique correspondence between the nodes of the two graphs preserving connections, otherwise false.
+ * Returns the next candidate of a stack element and moves it past that candidate, -1 when every candidate has been tried.
+ * Without a value ordering, the candidates are tried in the order of the scan (_scan_candidate).
+ * With one, the whole scan is run again and the candidate not yet tried with the smallest rank (candidate_rank) is returned,
+ * the earliest in the scan on a tie; the element keeps its rank and its position, since the scan always gives the candidates
+ * in the same order. The scan stops early at a candidate with the rank of the last one tried, which no other can beat.
+ */
+static int _next_candidate(VF2ppState* state, NodeCandidates* element) {
+    if (!state->use_value_order) {
+        return _scan_candidate(state, element, &element->cursor);
+    }
+    int best = -1;
+    long best_rank = 0;
+    int best_cursor = 0;
+    int cursor = 0;
+    int candidate;
+    while ((candidate = _scan_candidate(state, element, &cursor)) != -1) {
+        long rank = candidate_rank(&state->ranks, state->G1, state->G2, element->node, candidate);
+        bool tried = rank < element->rank || (rank == element->rank && cursor <= element->cursor);
+        if (!tried && (best == -1 || rank < best_rank)) {
+            best = candidate;
+            best_rank = rank;
+            best_cursor = cursor;
+            if (rank == element->rank) {
+                break;
+            }
+        }
+    }
+    if (best != -1) {
+        element->rank = best_rank;
+        element->cursor = best_cursor;
+    }
+    return best;
+}
+
+/**
+ * Copies the node signatures of a graph to its complement: a mapping preserves them on the complements too, since the complements
+ * have the same mappings, and they can be set by the caller (see core.h) as keys that the search must preserve.
+ */
+static bool _copy_signatures(Graph* from, Graph* to) {
+    to->signature = (uint64_t*)malloc(from->num_nodes * sizeof(uint64_t));
+    if(to->signature == NULL){
+        fprintf(stderr, "ERROR: complement signatures allocation error");
+        return false;
+    }
+    memcpy(to->signature, from->signature, from->num_nodes * sizeof(uint64_t));
+    return true;
+}
+
+/**
+ * Prepares a resumable VF2++ search between G1 and G2.
  * 
  * 1. Initial checks:
  *    Verify that both graphs have at least one node.
- *    Compare the number of nodes of G1 and G2. If different, the graphs cannot be isomorphic.
- *    Allocates and initializes T2_tilde (all true).
- *    Generates an optimal ordering of G1 nodes (node_order) for matching.
- * 
- * 2. Stack preparation:
- *    Initializes a stack to keep track of partial matches during the search.
- *    Finds the initial candidates for the first node in node_order and adds them to the stack.
- * 
- * 3. Match search:
- *    While the stack is not empty:
- *       Retrieves the current node (current_node) and its candidates.
- *       For each candidate not yet verified:
- *           Checks whether it is a valid mapping. If yes:
- *               Updates the data structures (mapping, T2_tilde) to reflect this mapping.
- *               Finds candidates for the next node and adds them to the stack.
- *           If all nodes are mapped, returns true (found a complete match).
- *       If no valid match is possible:
- *          Removes the current node from the stack and restores the previous state (_restore_Tinout).
+ *    Compare the number of nodes and the number of edges (sum of the degrees) of G1 and G2. If different, the graphs cannot be isomorphic.
+ *    Clears the `mapped` field of every node, so that the same graph can be used by several searches one after the other.
  * 
- * 4. Final deallocation:
- *    Frees up memory used by T2_tilde, node_order, and the stack.
- *    Returns false if no complete match is found.
+ * 2. State preparation:
+ *    Copies the options (the default ones when `options` is NULL).
+ *    When symmetry breaking is enabled, gets the symmetry data cached with G1 (computing them the first time, before the
+ *    `mapped` fields are cleared, since the automorphism search uses them) and allocates the forbidden pairs.
+ *    When more than COMPLEMENT_MIN_DENSITY of the possible edges are present, replaces G1 and G2 with their complements for the
+ *    rest of the search: an automorphism of G1 is an automorphism of its complement, so the symmetry data are still valid.
+ *    The signatures already cached with both inputs are copied to the complements (_copy_signatures), so that they are still
+ *    used as node keys.
+ *    When the signatures are enabled, computes them (once per graph searched) and stops if the two graphs have different signatures.
+ *    Builds the bitsets used to intersect the neighborhoods of the mapped neighbors, when G2 is small enough, with the nodes of G2
+ *    classified by signature (or by degree, without the signatures).
+ *    Allocates and initializes the frontier bitsets: no mapped nodes, every node in T1_tilde/T2_tilde; the frontier uses the
+ *    adjacency bitsets of the graphs when the candidate bitsets are built too.
+ *    Generates an optimal ordering of G1 nodes (node_order) for matching, with the ties broken by the seed, if any.
+ *    Reserves every buffer of the search once: the conflict sets of backjumping (when the adjacency bitsets are available),
+ *    the domains of forward checking, the keys of the dynamic order and the matching of the all-different propagator (when
+ *    requested, with the same bitsets), the ranks of the value ordering and the buffers of the endgame (when requested) and a stack with one element per
+ *    node, so that the search loop never allocates memory.
+ *    When requested, filters the domains by arc consistency before the search, and stops if one of them is emptied.
+ *    Finds the initial candidates for the first node (the first in node_order, or the one with the fewest candidates with the
+ *    dynamic order) and adds them to the stack.
  */
-bool vf2pp_is_isomorphic(Graph* G1, Graph* G2) {
+VF2ppState* vf2pp_init(Graph* G1, Graph* G2, const VF2ppOptions* options) {
     if (G1->num_nodes == 0 || G2->num_nodes == 0) {
-        return false;
+        return NULL;
     }
 
     // Check basic graph properties
     if (G1->num_nodes != G2->num_nodes) {
-        return false;
+        return NULL;
+    }
+    long long degree_sum1 = 0, degree_sum2 = 0;
+    for (int i = 0; i < G1->num_nodes; i++) {
+        degree_sum1 += G1->nodes[i].num_neighbors;
+        degree_sum2 += G2->nodes[i].num_neighbors;
+    }
+    if (degree_sum1 != degree_sum2) {
+        return NULL;
+    }
+
+    VF2ppOptions default_options;
+    if(options == NULL){
+        vf2pp_default_options(&default_options);
+        options = &default_options;
+    }
+    Symmetry* symmetry = NULL;
+    if(options->symmetry_breaking){
+        symmetry = graph_symmetry(G1);
+    }
+
+    for (int i = 0; i < G1->num_nodes; i++) {
+        G1->nodes[i].mapped = -1;
+        G2->nodes[i].mapped = -1;
+    }
+
+    // Dense graphs: search their complements, with the same mappings
+    Graph* input1 = G1;
+    Graph* input2 = G2;
+    double possible_edges = (double)G1->num_nodes * (G1->num_nodes - 1) / 2;
+    bool complemented = degree_sum1 / 2 > COMPLEMENT_MIN_DENSITY * possible_edges;
+    if(complemented){
+        G1 = complementGraph(input1);
+        G2 = complementGraph(input2);
+        if(G1 != NULL && G2 != NULL && input1->signature != NULL && input2->signature != NULL
+           && !(_copy_signatures(input1, G1) && _copy_signatures(input2, G2))){
+            freeGraph(G1);
+            G1 = NULL;
+        }
+        if(G1 == NULL || G2 == NULL){
+            if(G1 != NULL) freeGraph(G1);
+            if(G2 != NULL) freeGraph(G2);
+            G1 = input1;
+            G2 = input2;
+            complemented = false;
+        }
     }
 
-    bool* T2_tilde =(bool*)malloc(G2->num_nodes*sizeof(bool));
-    if(T2_tilde == NULL){
-      fprintf(stderr, "ERROR: T2 Tilde error");
-      return false;
+    VF2ppState* state = NULL;
+    if(!options->signatures || signatures_compatible(G1, G2)){
+        state = (VF2ppState*)malloc(sizeof(VF2ppState));
+        if(state == NULL){
+          fprintf(stderr, "ERROR: VF2++ state error");
+        }
+    }
+    if(state == NULL){
+        if(complemented){
+            freeGraph(G1);
+            freeGraph(G2);
+        }
+        return NULL;
     }
-    memset(T2_tilde, 1, G2->num_nodes * sizeof(bool)); // Initialize all elements to true (1)
+    state->G1 = G1;
+    state->G2 = G2;
+    state->input1 = input1;
+    state->input2 = input2;
+    state->complemented = complemented;
+    state->options = *options;
+    vf2pp_clear_stats(&state->stats);
+    state->stats.heap_calls = 0;
+    state->budget_exceeded = false;
+    state->symmetry = symmetry;
+    state->stack.elements = NULL;
+    state->stack.top = -1;
+    state->backjumping = false;
+    memset(&state->conflicts, 0, sizeof(ConflictSets));
+    state->use_nogoods = false;
+    memset(&state->nogoods, 0, sizeof(Nogoods));
+    state->use_domains = false;
+    memset(&state->domains, 0, sizeof(Domains));
+    state->dynamic = false;
+    memset(&state->order, 0, sizeof(DynamicOrder));
+    state->use_all_different = false;
+    memset(&state->all_different, 0, sizeof(AllDifferent));
+    state->use_value_order = false;
+    memset(&state->ranks, 0, sizeof(ValueRanks));
+    state->use_endgame = false;
+    memset(&state->endgame, 0, sizeof(Endgame));
+    state->finished = false;
+    state->use_filter = init_candidate_filter(&state->filter, G1, G2);
+    bool frontier_ok = init_frontier(&state->frontier, G1, G2, state->use_filter);
 
-    int* node_order = (int*)malloc(G1->num_nodes*sizeof(int));
-    if(node_order == NULL){
-      fprintf(stderr, "ERROR: Node order error");
-      return false;
+    state->node_order = (int*)malloc(G1->num_nodes*sizeof(int));
+    state->orbit = NULL;
+    state->visited = NULL;
+    if(symmetry != NULL){
+        state->orbit = (int*)malloc(G1->num_nodes * sizeof(int));
+        state->visited = (bool*)calloc(G1->num_nodes, sizeof(bool));
+        init_forbidden_pairs(&state->forbidden, G1->num_nodes);
+    }
+    if(!frontier_ok || state->node_order == NULL || (symmetry != NULL && (state->orbit == NULL || state->visited == NULL))){
+      fprintf(stderr, "ERROR: VF2++ state allocation error");
+      vf2pp_free(state);
+      return NULL;
     }
  
-    matching_order(G1,node_order);// Get optimal node ordering
-    
-    // Main matching logic
-    Stack stack;
-    init_stack(&stack);
+    matching_order_seeded(G1, state->node_order, options->seed);// Get optimal node ordering
 
-    int size_candidates;
-    int* candidates = _find_candidates(node_order[0], G1, G2, &size_candidates, T2_tilde);
+    state->backjumping = state->use_filter && state->frontier.adjacency1 != NULL
+                         && init_conflict_sets(&state->conflicts, state->node_order, G1->num_nodes);
+    state->use_domains = (options->forward_checking || options->dynamic_order || options->all_different_period > 0 || options->arc_consistency)
+                         && state->use_filter && state->frontier.adjacency1 != NULL
+                         && init_domains(&state->domains, G1, &state->filter);
+    if(state->use_domains && options->arc_consistency
+       && !arc_consistency(&state->domains, G1, &state->filter, state->frontier.adjacency2)){
+        vf2pp_free(state);
+        return NULL;
+    }
+    state->dynamic = options->dynamic_order && state->use_domains && init_dynamic_order(&state->order, G1, &state->filter, state->node_order);
+    state->use_all_different = options->all_different_period > 0 && state->use_domains
+                               && init_all_different(&state->all_different, G1->num_nodes, state->filter.words, options->all_different_period);
+    state->use_nogoods = options->nogoods && !state->dynamic && init_nogoods(&state->nogoods, G1, state->node_order);
+    state->use_value_order = options->value_order != VALUE_ORDER_SCAN
+                             && init_value_ranks(&state->ranks, options->value_order, G1, G2, options->value_hint, options->value_hint_nodes, options->seed);
+    state->stats.value_order = state->use_value_order ? options->value_order : VALUE_ORDER_SCAN;
+    int endgame_threshold = options->endgame_threshold < ENDGAME_MAX_NODES ? options->endgame_threshold : ENDGAME_MAX_NODES;
+    if(endgame_threshold > G1->num_nodes - 1){
+        endgame_threshold = G1->num_nodes - 1;
+    }
+    state->use_endgame = endgame_threshold > 0 && init_endgame(&state->endgame, G1->num_nodes, endgame_threshold);
 
-    NodeCandidates node;
-    node.node = node_order[0];
-    node.candidates = candidates;
-    node.num_candidates = size_candidates;
-    push(&stack, node);
+    init_stack(&state->stack, G1->num_nodes);
+
+    state->matching_node = 0;
+    push(&state->stack, _next_node(state));
 
-    int matching_node = 1;
-    int num_mapping = 0;
+    state->matching_node = 1;
+    state->num_mapping = 0;
+    state->pending = false;
+
+    return state;
+}
+
+/**
+ * Adds the heap calls made since `start` to the statistics of the search, when the heap counter is enabled, and copies the
+ * counters of the table of nogoods.
+ */
+static void _update_stats(VF2ppState* state, long start) {
+    if (start < 0) {
+        state->stats.heap_calls = -1;
+    } else {
+        state->stats.heap_calls += heap_calls() - start;
+    }
+    state->stats.nogood_lookups = state->nogoods.table.lookups;
+    state->stats.nogood_hits = state->nogoods.table.hits;
+}
+
+/**
+ * Copies the complete mapping of G1 to `mapping`, when it is not NULL, and to the input graphs when the search runs on their
+ * complements.
+ */
+static void _report_mapping(VF2ppState* state, int* mapping) {
+    Graph* G1 = state->G1;
+    Graph* G2 = state->G2;
+    if(mapping != NULL){
+        for(int u=0; u<G1->num_nodes; u++){
+            mapping[u] = G1->nodes[u].mapped;
+        }
+    }
+    if(state->complemented){
+        for(int u=0; u<G1->num_nodes; u++){
+            state->input1->nodes[u].mapped = G1->nodes[u].mapped;
+            state->input2->nodes[u].mapped = G2->nodes[u].mapped;
+        }
+    }
+}
+
+/**
+ * Implements the VF2++ algorithm to find the next mapping between the graphs G1 and G2. 
+ * A mapping is a biunique correspondence between the nodes of the two graphs preserving connections.
+ * The search stops as soon as a mapping is found, and the next call resumes it from the same point.
+ * 
+ * 1. Resume:
+ *    If the previous call returned a mapping, the last node of node_order is still mapped: it is unmapped, so that its next candidate is tried.
+ * 
+ * 2. Match search:
+ *    While the stack is not empty:
+ *       Retrieves the current node (current_node) and its candidates.
+ *       For each candidate not yet verified (from the cursor of the stack element on, or by rank with a value ordering):
+ *           Skips it if symmetry breaking has forbidden the pair (current_node, candidate).
+ *           Skips it if the consistency check or the cut rules of VF2++ reject the pair (_cut_reason).
+ *           With backjumping, the reason of the rejection is added to the conflict set of the depth (_explain_rejection);
+ *           a forbidden pair depends on the whole mapping, so it adds every earlier depth.
+ *           Counts the new state, and stops the search if the limit on the states is exceeded.
+ *           If it is the last node to be mapped, completes the mapping, copies it to `mapping` (and to the input graphs, when
+ *           the search runs on their complements) and returns true; its depth gets every earlier depth in the conflict set,
+ *           so that the search resumes from there.
+ *           Otherwise:
+ *               Updates the data structures (mapping, frontier) to reflect this mapping.
+ *               With forward checking, narrows the domains of the unmapped neighbors of current_node; if one of them is left
+ *               without candidates, the pair is removed at once, with the reasons why that node has no candidates as the
+ *               reason of the rejection.
+ *               With the all-different propagator, every `all_different_period` depths matches the nodes of T1 to their
+ *               candidates (propagate_all_different), pruning the domains; if no matching covers T1, the pair is removed,
+ *               with every earlier depth as the reason.
+ *               With the endgame, when `endgame_threshold` nodes are left unmapped, matches them in a single step
+ *               (solve_endgame): a completion is copied like the last node's one and ends the search; if there is none,
+ *               the pair is removed, with every earlier depth as the reason; if the endgame gives up, the search goes on.
+ *               Pushes the next node (_next_node) on the stack with an empty conflict set; its candidates are found one at a
+ *               time, when the loop asks for them.
+ *       If no valid match is possible:
+ *          Without backjumping, goes back to the previous depth. With it, adds to the conflict set the reasons why the other
+ *          nodes of G2 were not candidates (_explain_candidates) and jumps back to the deepest depth of the set, which
+ *          inherits the rest of it (conflict_jump); the depths in between are undone without trying their other candidates,
+ *          since no assignment of theirs can avoid the failure. An empty set ends the search.
+ *          Removes the nodes from the stack and restores the previous frontier (_restore_Tinout).
+ *          With symmetry breaking, the pairs found below the removed node are discarded; then, since the mapping of the previous
+ *          node (u -> v) has failed, every node that an automorphism fixing the mapped nodes sends u to is forbidden from v,
+ *          as long as the mapped nodes do not change.
+ * 
+ * 3. End of the search:
+ *    Returns false when the stack is empty, i.e. when every mapping has already been returned.
+ *
+ * No memory is allocated in the loop (only the forbidden pairs of symmetry breaking may grow); the heap calls are counted in the statistics.
+ */
+bool vf2pp_next(VF2ppState* state, int* mapping) {
+    Graph* G1 = state->G1;
+    Graph* G2 = state->G2;
+    Stack* stack = &state->stack;
+
+    if(state->budget_exceeded || state->finished){
+        return false;
+    }
+    if(state->pending){
+        int last_node = stack->elements[stack->top].node;
+        G2->nodes[G1->nodes[last_node].mapped].mapped = -1;
+        G1->nodes[last_node].mapped = -1;
+        state->pending = false;
+    }
 
-    while(stack.top != -1){
+    long heap_calls_start = heap_calls();
+    while(stack->top != -1){
         bool found = false;
-        NodeCandidates* node_candidate_current = &stack.elements[stack.top];
+        NodeCandidates* node_candidate_current = &stack->elements[stack->top];
         int current_node = node_candidate_current->node;
-        int candidates_nodes_size = node_candidate_current->num_candidates;
-        for(int i=0; i< candidates_nodes_size; i++){
-            int candidate = node_candidate_current->candidates[i];
-            if(node_candidate_current->flags[i]== false){
-                if (num_mapping == G2->num_nodes -1 ){
-                    G1->nodes[current_node].mapped = candidate;
-                    free_stack(&stack);
-                    free(node_order);
-                    free(T2_tilde);
+        int candidate;
+        for(bool first = (node_candidate_current->cursor == 0); (candidate = _next_candidate(state, node_candidate_current)) != -1; first = false){
+            if(state->symmetry != NULL && is_forbidden_pair(&state->forbidden, current_node, candidate)){
+                if(state->backjumping){
+                    add_all_conflicts(&state->conflicts, stack->top);
+                }
+                continue;
+            }
+            int reason = _cut_reason(G1, G2, current_node, candidate, &state->frontier);
+            if(reason != CUT_NONE){
+                if(state->backjumping && !state->conflicts.full[stack->top]){
+                    _explain_rejection(state, stack->top, current_node, candidate, reason);
+                }
+                continue;
+            }
+            state->stats.num_states++;
+            state->stats.first_choices += first;
+            if(state->options.max_states > 0 && state->stats.num_states > state->options.max_states){
+                state->budget_exceeded = true;
+                _update_stats(state, heap_calls_start);
+                return false;
+            }
+            G1->nodes[current_node].mapped = candidate;
+            G2->nodes[candidate].mapped = current_node;
+            if (state->num_mapping == G2->num_nodes -1 ){
+                _report_mapping(state, mapping);
+                if(state->backjumping){
+                    add_all_conflicts(&state->conflicts, stack->top);
+                }
+                state->nogoods.recording = false;
+                state->pending = true;
+                _update_stats(state, heap_calls_start);
+                return true;
+            }
+            if(state->use_nogoods){
+                extend_fingerprint(&state->nogoods, G1, stack->top, current_node, candidate);
+                if(is_nogood(&state->nogoods, stack->top + 1)){
+                    G1->nodes[current_node].mapped = -1;
+                    G2->nodes[candidate].mapped = -1;
+                    if(state->backjumping){
+                        add_all_conflicts(&state->conflicts, stack->top);
+                    }
+                    continue;
+                }
+            }
+            state->num_mapping++;
+            _update_Tinout(G1, G2, current_node, candidate, &state->frontier);
+            if(state->backjumping){
+                state->conflicts.depth_of[current_node] = stack->top;
+                _record_entries(state, stack->top);
+            }
+            if(state->use_domains){
+                int wiped = narrow_domains(&state->domains, G1, state->frontier.adjacency2, current_node, candidate, state->frontier.T2, state->dynamic ? &state->order : NULL);
+                if(wiped != -1){
+                    if(state->backjumping && !state->conflicts.full[stack->top]){
+                        _explain_candidates(state, stack->top, wiped);
+                    }
+                    _unmap_top(state);
+                    continue;
+                }
+            }
+            if(state->use_all_different
+               && !propagate_all_different(&state->all_different, &state->domains, state->frontier.T1, state->frontier.T2, stack->top)){
+                if(state->backjumping){
+                    add_all_conflicts(&state->conflicts, stack->top);
+                }
+                _unmap_top(state);
+                continue;
+            }
+            if(state->use_endgame && G1->num_nodes - state->num_mapping == state->endgame.threshold){
+                state->stats.endgames++;
+                int result = solve_endgame(&state->endgame, G1, G2);
+                if(result == ENDGAME_FOUND){
+                    _report_mapping(state, mapping);
+                    state->finished = true;
+                    _update_stats(state, heap_calls_start);
                     return true;
                 }
-                node_candidate_current->flags[i] = true;
-                G1->nodes[current_node].mapped = candidate;
-                G2->nodes[candidate].mapped = current_node;
-                num_mapping++;
-                _update_Tinout(G2, candidate,T2_tilde);
-
-                int size_next_candidates;
-                int* next_candidates = _find_candidates(node_order[matching_node], G1, G2, &size_next_candidates,T2_tilde);
-                NodeCandidates node_next;
-                node_next.num_candidates = size_next_candidates;
-                node_next.node = node_order[matching_node];
-                node_next.candidates = next_candidates;
-                push(&stack, node_next);
-
-                matching_node++;
-                found = true;
-                break;
+                if(result == ENDGAME_NONE){
+                    if(state->backjumping){
+                        add_all_conflicts(&state->conflicts, stack->top);
+                    }
+                    _unmap_top(state);
+                    continue;
+                }
+            }
+            if(state->backjumping){
+                clear_conflict_set(&state->conflicts, stack->top + 1);
             }
+
+            push(stack, _next_node(state));
+
+            state->matching_node++;
+            found = true;
+            break;
         }
         if(found == false){
-            pop(&stack);
-            matching_node -= 1;
-            if(stack.top != -1){
-                NodeCandidates* popped_node = &stack.elements[stack.top];
-                int popped_node1 = popped_node->node;
+            int target = stack->top - 1;
+            if(state->backjumping){
+                if(!state->conflicts.full[stack->top]){
+                    _explain_candidates(state, stack->top, current_node);
+                }
+                target = conflict_jump(&state->conflicts, stack->top);
+            }
+            if(state->use_nogoods){
+                for(int d = stack->top; d > target; d--){
+                    record_nogood(&state->nogoods, d);
+                }
+            }
+            pop(stack);
+            while(stack->top > target){
+                _unmap_top(state);
+                pop(stack);
+            }
+            state->matching_node = stack->top + 1;
+            if(stack->top != -1){
+                int popped_node1 = stack->elements[stack->top].node;
                 int popped_node2 = G1->nodes[popped_node1].mapped;
-                G1->nodes[popped_node1].mapped = -1;
-                G2->nodes[popped_node2].mapped = -1;
-                num_mapping -= 1;
-                _restore_Tinout(G2, popped_node2, T2_tilde);
+                _unmap_top(state);
+
+                if(state->symmetry != NULL){
+                    backtrack_forbidden_pairs(&state->forbidden, stack->top + 1);
+                    int orbit_size = stabilizer_orbit(state->symmetry, G1, popped_node1, state->orbit, state->visited);
+                    for(int j = 0; j < orbit_size; j++){
+                        add_forbidden_pair(&state->forbidden, state->orbit[j], popped_node2, stack->top);
+                    }
+                }
             }
         }
-        continue;
     }
-    free_stack(&stack);
-    free(node_order);
-    free(T2_tilde);
+    _update_stats(state, heap_calls_start);
     return false;
-}
\ No newline at end of file
+}
+
+/**
+ * Frees up memory used by the frontier, the candidate bitsets, node_order, the stack, the symmetry breaking buffers,
+ * the conflict sets, the domains, the matching of the all-different propagator, the ranks of the value ordering, the buffers of the endgame, the complements of the graphs (if the search ran on them) and the state itself.
+ * It also accepts a state whose initialization failed halfway.
+ * The `mapped` fields of the input graphs are left untouched, so the last mapping found is still available in G1.
+ */
+void vf2pp_free(VF2ppState* state) {
+    free_stack(&state->stack);
+    free(state->node_order);
+    free_frontier(&state->frontier);
+    free_candidate_filter(&state->filter);
+    free_conflict_sets(&state->conflicts);
+    free_nogoods(&state->nogoods);
+    free_domains(&state->domains);
+    free_dynamic_order(&state->order);
+    free_all_different(&state->all_different);
+    free_value_ranks(&state->ranks);
+    free_endgame(&state->endgame);
+    if(state->symmetry != NULL){
+        free_forbidden_pairs(&state->forbidden);
+        free(state->orbit);
+        free(state->visited);
+    }
+    if(state->complemented){
+        freeGraph(state->G1);
+        freeGraph(state->G2);
+    }
+    free(state);
+}
+
+/**
+ * Checks whether two graphs G1 and G2 are isomorphic, stopping at the first mapping found.
+ * Returns true if there is a biunique correspondence between the nodes of the two graphs preserving connections, otherwise false.
+ * When the graphs are isomorphic, the `mapped` field of each node of G1 contains its image in G2.
+ */
+bool vf2pp_is_isomorphic(Graph* G1, Graph* G2) {
+    return vf2pp_is_isomorphic_with_options(G1, G2, NULL, NULL);
+}
+
+/**
+ * Returns term i (from 1) of Luby's sequence 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, ...: 2^(k-1) when i = 2^k - 1, otherwise the term
+ * i - 2^(k-1) + 1, where 2^(k-1) <= i < 2^k - 1.
+ */
+static long _luby(long i) {
+    for (;;) {
+        int k = 1;
+        while ((1L << k) - 1 < i) {
+            k++;
+        }
+        if ((1L << k) - 1 == i) {
+            return 1L << (k - 1);
+        }
+        i -= (1L << (k - 1)) - 1;
+    }
+}
+
+/**
+ * Runs the search with restarts (see VF2ppOptions::restart_base):
+ * 1. Run i explores at most restart_base * _luby(i) states, or the states left of `max_states`, if fewer: then it is the last.
+ * 2. The first run uses the options as they are; run i > 1 uses a seed derived from `seed` and i, and, with VALUE_ORDER_SCAN,
+ *    the random value order.
+ * 3. With the nogoods, the table of the previous run moves to the new one (transfer_nogoods) when both runs have the same node
+ *    order (no ties were broken), since a nogood names the images of the first nodes of the order: the subproblems that failed
+ *    in a run are then skipped by the next ones.
+ * 4. A run that ends before its cutoff decides the graphs; the statistics are the sums over the runs, so a search stopped by
+ *    `max_states` has explored max_states + 1 states, like a single run.
+ */
+static bool _search_restarts(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats) {
+    VF2ppOptions run_options = *options;
+    VF2ppStats total;
+    vf2pp_clear_stats(&total);
+    VF2ppState* previous = NULL;
+    bool isIso = false;
+    for (long run = 1; ; run++) {
+        long cutoff = options->restart_base * _luby(run);
+        bool last = options->max_states > 0 && cutoff >= options->max_states - total.num_states;
+        run_options.max_states = last ? options->max_states - total.num_states : cutoff;
+        if (run > 1) {
+            run_options.seed = ((options->seed + (uint64_t)run) * 0x9e3779b97f4a7c15ULL) | 1;
+            if (options->value_order == VALUE_ORDER_SCAN) {
+                run_options.value_order = VALUE_ORDER_RANDOM;
+            }
+        }
+        VF2ppState* state = vf2pp_init(G1, G2, &run_options);
+        if (state == NULL) {
+            break;
+        }
+        if (previous != NULL) {
+            if (state->use_nogoods && previous->use_nogoods
+                && memcmp(state->node_order, previous->node_order, state->G1->num_nodes * sizeof(int)) == 0) {
+                transfer_nogoods(&state->nogoods, &previous->nogoods);
+            }
+            vf2pp_free(previous);
+            previous = NULL;
+        }
+        long lookups = state->nogoods.table.lookups;
+        long hits = state->nogoods.table.hits;
+        isIso = vf2pp_next(state, NULL);
+        total.num_states += state->stats.num_states;
+        if (total.heap_calls >= 0 && state->stats.heap_calls >= 0) {
+            total.heap_calls += state->stats.heap_calls;
+        }
+        total.nogood_lookups += state->nogoods.table.lookups - lookups;
+        total.nogood_hits += state->nogoods.table.hits - hits;
+        total.value_order = state->stats.value_order;
+        total.first_choices += state->stats.first_choices;
+        total.endgames += state->stats.endgames;
+        if (!state->budget_exceeded || last) {
+            vf2pp_free(state);
+            break;
+        }
+        total.restarts++;
+        previous = state;
+    }
+    if (previous != NULL) {
+        vf2pp_free(previous);
+    }
+    *stats = total;
+    return isIso;
+}
+
+/**
+ * Runs a single search of the whole graphs: with sets of one or two words when they are small enough (see small_search.h),
+ * the general one otherwise, with restarts when requested (_search_restarts). A search stopped by `max_states` has explored
+ * max_states + 1 states.
+ */
+static bool _search_whole(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats) {
+    if(options != NULL && options->restart_base > 0){
+        return _search_restarts(G1, G2, options, stats);
+    }
+    int small_result = small_isomorphic(G1, G2, options, stats);
+    if(small_result >= 0){
+        return small_result == 1;
+    }
+    VF2ppState* state = vf2pp_init(G1, G2, options);
+    if(state == NULL){
+        vf2pp_clear_stats(stats);
+        return false;
+    }
+    bool isIso = vf2pp_next(state, NULL);
+    *stats = state->stats;
+    vf2pp_free(state);
+    return isIso;
+}
+
+/**
+ * Decides a stalled search by the canonical certificates of the graphs (see canonical.h). When they are equal, the mapping given
+ * by the canonical labels is copied to the `mapped` fields of both graphs. Returns 1 if the graphs are isomorphic, 0 if they are
+ * not, -1 if memory cannot be allocated.
+ */
+static int _certificate_isomorphic(Graph* G1, Graph* G2) {
+    Certificate* c1 = compute_certificate(G1, NULL);
+    Certificate* c2 = (c1 != NULL) ? compute_certificate(G2, NULL) : NULL;
+    int* mapping = (int*)malloc(G1->num_nodes * sizeof(int));
+    int result = -1;
+    if(c1 != NULL && c2 != NULL && mapping != NULL){
+        result = certificate_mapping(c1, c2, mapping) ? 1 : 0;
+        for(int u=0; u<G1->num_nodes; u++){
+            G1->nodes[u].mapped = result ? mapping[u] : -1;
+            G2->nodes[u].mapped = -1;
+        }
+        for(int u=0; u<G1->num_nodes && result; u++){
+            G2->nodes[mapping[u]].mapped = u;
+        }
+    }else{
+        fprintf(stderr, "ERROR: certificate allocation error");
+    }
+    free(mapping);
+    free_certificate(c1);
+    free_certificate(c2);
+    return result;
+}
+
+/**
+ * Same as vf2pp_is_isomorphic, with the optional features selected by `options`, copying the statistics of the search to `stats`.
+ * A forest G1 is decided without any search (see forest.h), a disconnected G1 is matched component by component
+ * (see components.h), when nodes of degree 1 hang from G1, only the 2-cores are searched (see core.h) and, when G1 has twins,
+ * only the quotient graphs are searched (see twins.h); graphs of at most SMALL_SEARCH_MAX_NODES nodes are searched with sets of
+ * one or two words (see small_search.h), and a single search of the whole graphs is run otherwise (_search_whole).
+ * With `fallback_states` (below a positive `max_states`, if any), that search is run with `fallback_states` as its budget: when
+ * it runs out, the graphs are decided by their canonical certificates (_certificate_isomorphic), or, if these cannot be
+ * computed, by the search without the budget.
+ */
+bool vf2pp_is_isomorphic_with_options(Graph* G1, Graph* G2, const VF2ppOptions* options, VF2ppStats* stats) {
+    int forest_result = forest_isomorphic(G1, G2, stats);
+    if(forest_result >= 0){
+        return forest_result == 1;
+    }
+    int components_result = vf2pp_components_isomorphic(G1, G2, options, stats);
+    if(components_result >= 0){
+        return components_result == 1;
+    }
+    int core_result = core_isomorphic(G1, G2, options, stats);
+    if(core_result >= 0){
+        return core_result == 1;
+    }
+    int twins_result = twins_isomorphic(G1, G2, options, stats);
+    if(twins_result >= 0){
+        return twins_result == 1;
+    }
+    VF2ppStats local_stats;
+    if(stats == NULL){
+        stats = &local_stats;
+    }
+    bool fallback = options != NULL && options->fallback_states > 0
+                    && (options->max_states <= 0 || options->fallback_states < options->max_states);
+    if(!fallback){
+        return _search_whole(G1, G2, options, stats);
+    }
+    VF2ppOptions search_options = *options;
+    search_options.max_states = options->fallback_states;
+    bool isIso = _search_whole(G1, G2, &search_options, stats);
+    if(stats->num_states <= search_options.max_states){
+        return isIso;
+    }
+    stats->fallbacks++;
+    int certificate_result = _certificate_isomorphic(G1, G2);
+    if(certificate_result >= 0){
+        return certificate_result == 1;
+    }
+    long fallbacks = stats->fallbacks;
+    search_options.max_states = options->max_states;
+    isIso = _search_whole(G1, G2, &search_options, stats);
+    stats->fallbacks += fallbacks;
+    return isIso;
+}
+
+/**
+ * Every optional feature is disabled, so the search is the plain VF2++ one.
+ */
+void vf2pp_default_options(VF2ppOptions* options) {
+    options->symmetry_breaking = false;
+    options->max_states = 0;
+    options->signatures = false;
+    options->nogoods = false;
+    options->forward_checking = false;
+    options->dynamic_order = false;
+    options->all_different_period = 0;
+    options->arc_consistency = false;
+    options->value_order = VALUE_ORDER_SCAN;
+    options->value_hint = NULL;
+    options->value_hint_nodes = 0;
+    options->endgame_threshold = 0;
+    options->fallback_states = 0;
+    options->seed = 0;
+    options->restart_base = 0;
+}
+
+/**
+ * Statistics of an empty search.
+ */
+void vf2pp_clear_stats(VF2ppStats* stats) {
+    stats->num_states = 0;
+    stats->heap_calls = (heap_calls() < 0) ? -1 : 0;
+    stats->nogood_lookups = 0;
+    stats->nogood_hits = 0;
+    stats->value_order = VALUE_ORDER_SCAN;
+    stats->first_choices = 0;
+    stats->endgames = 0;
+    stats->fallbacks = 0;
+    stats->restarts = 0;
+}